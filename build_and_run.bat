@@ -17,6 +17,7 @@ if not exist obj mkdir obj
 if not exist obj\ui mkdir obj\ui
 if not exist obj\world mkdir obj\world 
 if not exist obj\engine mkdir obj\engine
+if not exist obj\render mkdir obj\render
 if not exist bin mkdir bin
 if not exist bin\assets mkdir bin\assets
 if not exist bin\assets\textures mkdir bin\assets\textures
@@ -75,9 +76,21 @@ echo Compiling project...
 g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/main.cpp -o obj/main.o
 g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/World.cpp -o obj/world/World.o
 g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/engine/Camera.cpp -o obj/engine/Camera.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/BiomeMap.cpp -o obj/world/BiomeMap.o
 g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/Chunk.cpp -o obj/world/Chunk.o
-g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/TileManager.cpp -o obj/world/TileManager.o
-g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/engine/PerlinNoise.cpp -o obj/engine/PerlinNoise.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/ChunkGenerator.cpp -o obj/world/ChunkGenerator.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/ChunkCache.cpp -o obj/world/ChunkCache.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/ChunkWindow.cpp -o obj/world/ChunkWindow.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/GenerationPipeline.cpp -o obj/world/GenerationPipeline.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/PendingTileWrites.cpp -o obj/world/PendingTileWrites.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/world/SurfaceIndex.cpp -o obj/world/SurfaceIndex.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/render/ChunkMesh.cpp -o obj/render/ChunkMesh.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/render/ChunkOverview.cpp -o obj/render/ChunkOverview.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/render/SectionBakeCache.cpp -o obj/render/SectionBakeCache.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/render/TileManager.cpp -o obj/render/TileManager.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/render/WorldRenderer.cpp -o obj/render/WorldRenderer.o
+g++ -Wall -Wextra -std=c++17 -O2 -ffp-contract=off -I./SFML/include -c src/engine/PerlinNoise.cpp -o obj/engine/PerlinNoise.o
+g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/engine/NoiseTileCache.cpp -o obj/engine/NoiseTileCache.o
 g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/ui/Button.cpp -o obj/ui/Button.o
 g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/ui/MenuState.cpp -o obj/ui/MenuState.o
 g++ -Wall -Wextra -std=c++17 -O2 -I./SFML/include -c src/ui/Slider.cpp -o obj/ui/Slider.o
@@ -91,7 +104,7 @@ if %ERRORLEVEL% NEQ 0 (
 )
 
 echo Linking...
-g++ obj/main.o obj/world/World.o obj/engine/Camera.o obj/world/Chunk.o obj/world/TileManager.o obj/engine/PerlinNoise.o obj/ui/Button.o obj/ui/MenuState.o obj/ui/Slider.o -o bin/main.exe -L./SFML/lib -lsfml-graphics -lsfml-window -lsfml-system -static-libgcc -static-libstdc++
+g++ obj/main.o obj/world/World.o obj/engine/Camera.o obj/world/BiomeMap.o obj/world/Chunk.o obj/world/ChunkGenerator.o obj/world/ChunkCache.o obj/world/ChunkWindow.o obj/world/GenerationPipeline.o obj/world/PendingTileWrites.o obj/world/SurfaceIndex.o obj/render/ChunkMesh.o obj/render/ChunkOverview.o obj/render/SectionBakeCache.o obj/render/TileManager.o obj/render/WorldRenderer.o obj/engine/PerlinNoise.o obj/engine/NoiseTileCache.o obj/ui/Button.o obj/ui/MenuState.o obj/ui/Slider.o -o bin/main.exe -L./SFML/lib -lsfml-graphics -lsfml-window -lsfml-system -static-libgcc -static-libstdc++
 
 if %ERRORLEVEL% NEQ 0 (
     echo.
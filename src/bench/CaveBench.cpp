@@ -0,0 +1,160 @@
+// Throughput benchmark for cave carving. Times scalar caveNoise against the batched
+// caveNoise and caveMask on every kernel the CPU supports (checking they agree with
+// the scalar path), then times the caves generation stage on real chunks against a
+// scalar loop over every cell below the roof.
+//
+// Usage: cave_bench [chunks]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../engine/PerlinNoise.h"
+#include "../world/BiomeMap.h"
+#include "../world/Chunk.h"
+#include "../world/SurfaceIndex.h"
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+const int CHUNK_WIDTH = 16;
+const int WORLD_HEIGHT = 200;
+const size_t SAMPLES = 1 << 18;
+const int REPEATS = 5;
+
+// Same parameters as Chunk::generateCaves
+const double CAVE_SCALE = 0.06;
+const float CAVE_THRESHOLD = 0.4f;
+
+double nanosecondsPerSample(size_t samples, Clock::time_point start) {
+    double nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return nanoseconds / (static_cast<double>(samples) * REPEATS);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int chunks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const unsigned long long seed = 98765432101ULL;
+    PerlinNoise noise(seed);
+
+    // A block of cave samples the shape of the underground part of the world
+    std::vector<float> xs(SAMPLES);
+    std::vector<float> ys(SAMPLES);
+    for (size_t i = 0; i < SAMPLES; i++) {
+        xs[i] = static_cast<float>((static_cast<int>(i % 2048) - 1024) * CAVE_SCALE);
+        ys[i] = static_cast<float>((static_cast<int>(i / 2048) + 70) * CAVE_SCALE);
+    }
+
+    std::cout << "Cave noise benchmark (" << SAMPLES << " samples)" << std::endl;
+
+    std::vector<float> reference(SAMPLES);
+    auto start = Clock::now();
+    for (int r = 0; r < REPEATS; r++) {
+        for (size_t i = 0; i < SAMPLES; i++) {
+            reference[i] = noise.caveNoise(xs[i], ys[i], 0.0f);
+        }
+    }
+    std::cout << "  caveNoise(x, y, z): " << nanosecondsPerSample(SAMPLES, start) << " ns/sample" << std::endl;
+
+    size_t referenceCarved = 0;
+    for (float value : reference) {
+        referenceCarved += value > CAVE_THRESHOLD;
+    }
+
+    NoiseKernel defaultKernel = PerlinNoise::getKernel();
+    const NoiseKernel kernels[] = {NoiseKernel::SCALAR, NoiseKernel::SSE2, NoiseKernel::AVX2};
+    std::vector<float> out(SAMPLES);
+    std::vector<uint8_t> carve(SAMPLES);
+    bool identical = true;
+
+    for (NoiseKernel kernel : kernels) {
+        if (!PerlinNoise::setKernel(kernel)) {
+            std::cout << "  " << PerlinNoise::getKernelName(kernel) << ": not supported" << std::endl;
+            continue;
+        }
+
+        start = Clock::now();
+        for (int r = 0; r < REPEATS; r++) {
+            noise.caveNoise(xs.data(), ys.data(), 0.0f, out.data(), SAMPLES);
+        }
+        double batch = nanosecondsPerSample(SAMPLES, start);
+        bool same = std::memcmp(out.data(), reference.data(), SAMPLES * sizeof(float)) == 0;
+        identical = identical && same;
+
+        size_t carved = 0;
+        start = Clock::now();
+        for (int r = 0; r < REPEATS; r++) {
+            carved = noise.caveMask(xs.data(), ys.data(), 0.0f, CAVE_THRESHOLD, carve.data(), SAMPLES);
+        }
+        double mask = nanosecondsPerSample(SAMPLES, start);
+
+        // The mask only shapes samples near the threshold, but must still agree exactly
+        size_t disagree = 0;
+        for (size_t i = 0; i < SAMPLES; i++) {
+            disagree += carve[i] != (reference[i] > CAVE_THRESHOLD);
+        }
+        same = same && disagree == 0;
+        identical = identical && same;
+
+        std::cout << "  " << PerlinNoise::getKernelName(kernel) << " batch: " << batch
+                  << " ns/sample, mask: " << mask << " ns/sample (" << carved << " carved, "
+                  << disagree << " differ from scalar)" << (same ? "" : "  MISMATCH") << std::endl;
+    }
+    PerlinNoise::setKernel(defaultKernel);
+    std::cout << "  scalar carves " << referenceCarved << " of " << SAMPLES << std::endl;
+
+    if (!identical) {
+        std::cerr << "Batched cave noise or the cave mask differs from the scalar path!" << std::endl;
+        return 1;
+    }
+
+    // The caves stage on freshly generated terrain
+    auto terrainNoise = std::make_shared<PerlinNoise>(seed);
+    SurfaceIndex surface(terrainNoise, WORLD_HEIGHT);
+    BiomeMap biomeMap(terrainNoise, WORLD_HEIGHT);
+    std::vector<int> heights(CHUNK_WIDTH);
+    std::vector<Biome> biomes(CHUNK_WIDTH);
+    double stageSeconds = 0.0;
+    double scalarSeconds = 0.0;
+    size_t cells = 0;
+    size_t carvedTiles = 0;
+    size_t scalarCarved = 0;
+
+    for (int c = 0; c < chunks; c++) {
+        Chunk chunk(c, CHUNK_WIDTH, WORLD_HEIGHT);
+        surface.getTerrainHeights(chunk.getWorldX(), CHUNK_WIDTH, heights.data());
+        biomeMap.getBiomes(chunk.getWorldX(), CHUNK_WIDTH, biomes.data());
+        chunk.generateTerrain(heights.data(), biomes.data(), biomeMap.getSeaLevel(), seed, chunk.getWorldX());
+
+        start = Clock::now();
+        carvedTiles += chunk.generateCaves(surface.getNoise(), heights.data(), chunk.getWorldX());
+        stageSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        // Reference: one scalar caveNoise call per cell below the roof
+        start = Clock::now();
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            float sampleX = static_cast<float>((chunk.getWorldX() + x) * CAVE_SCALE);
+            for (int y = heights[x] + Chunk::CAVE_ROOF_DEPTH; y < WORLD_HEIGHT - 1; y++) {
+                float sampleY = static_cast<float>(y * CAVE_SCALE);
+                scalarCarved += surface.getNoise().caveNoise(sampleX, sampleY, 0.0f) > CAVE_THRESHOLD;
+                cells++;
+            }
+        }
+        scalarSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::cout << "Caves stage (" << chunks << " chunks, " << cells / chunks << " cells each)" << std::endl;
+    std::cout << "  scalar per cell: " << scalarSeconds * 1.0e6 / chunks << " us per chunk" << std::endl;
+    std::cout << "  generateCaves: " << stageSeconds * 1.0e6 / chunks << " us per chunk, speedup "
+              << (stageSeconds > 0.0 ? scalarSeconds / stageSeconds : 0.0) << "x" << std::endl;
+    std::cout << "  carved " << 100.0 * carvedTiles / cells << "% of cells (scalar "
+              << 100.0 * scalarCarved / cells << "%)" << std::endl;
+
+    return 0;
+}
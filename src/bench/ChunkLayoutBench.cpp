@@ -0,0 +1,267 @@
+// Micro-benchmark comparing the old nested-vector chunk layout against the
+// flat 1-byte layout that replaced it (Chunk has since moved on to 16-row
+// sections), for simplified versions of three hot passes: terrain fill, tree
+// placement and mesh building. Also compares the old mt19937 stone variant
+// draw with the hashed one.
+//
+// Usage: chunk_bench [iterations]
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../engine/HashRandom.h"
+#include "../engine/PerlinNoise.h"
+#include "../world/Chunk.h"
+#include "../world/GenerationPipeline.h"
+#include "../world/SurfaceIndex.h"
+#include "../world/TileTypes.h"
+
+namespace {
+
+const int CHUNK_WIDTH = 16;
+const int WORLD_HEIGHT = 200;
+const int TILE_SIZE = 16;
+
+// Previous layout: one heap column per x and a 4-byte tile enum
+struct NestedLayout {
+    std::vector<std::vector<int32_t>> tiles;
+
+    NestedLayout() : tiles(CHUNK_WIDTH, std::vector<int32_t>(WORLD_HEIGHT, 0)) {}
+
+    TileType get(int x, int y) const { return static_cast<TileType>(tiles[x][y]); }
+    void set(int x, int y, TileType type) { tiles[x][y] = static_cast<int32_t>(type); }
+    void clear() { for (auto& col : tiles) std::fill(col.begin(), col.end(), 0); }
+};
+
+// Flat layout: one contiguous column-major buffer of 1-byte tiles
+struct FlatLayout {
+    std::vector<TileType> tiles;
+
+    FlatLayout() : tiles(CHUNK_WIDTH * WORLD_HEIGHT, TileType::AIR) {}
+
+    TileType get(int x, int y) const { return tiles[x * WORLD_HEIGHT + y]; }
+    void set(int x, int y, TileType type) { tiles[x * WORLD_HEIGHT + y] = type; }
+    void clear() { std::fill(tiles.begin(), tiles.end(), TileType::AIR); }
+};
+
+// A simplified terrain pass (heights straight from noise, no biomes or caves),
+// parameterised on storage
+template <typename Layout>
+void terrainPass(Layout& layout, const PerlinNoise& noise, uint64_t seed, int chunkX) {
+    const double scale = 0.05;
+    const int dirtLayers = 3;
+    const int baseHeight = WORLD_HEIGHT * 0.5;
+    const int hillHeight = WORLD_HEIGHT * 0.18;
+
+    const uint64_t stoneStream = HashRandom::streamKey(seed, RandomPurpose::STONE_VARIANT);
+
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        int worldX = chunkX * CHUNK_WIDTH + x;
+        double heightValue = noise.noise(worldX * scale, 0) * 0.5 + 0.5;
+        int terrainHeight = baseHeight - hillHeight * heightValue;
+
+        layout.set(x, terrainHeight, TileType::GRASS);
+        for (int dirt = 1; dirt <= dirtLayers; dirt++) {
+            layout.set(x, terrainHeight + dirt, TileType::DIRT);
+        }
+        for (int y = terrainHeight + dirtLayers + 1; y < WORLD_HEIGHT; y++) {
+            layout.set(x, y, HashRandom::coin(stoneStream, worldX, y) ? TileType::GRAVELED_STONE : TileType::STONE);
+        }
+    }
+
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        layout.set(x, WORLD_HEIGHT - 1, TileType::BEDROCK);
+    }
+}
+
+// A simplified tree pass: surface scan and leaf placement, kept within the chunk
+template <typename Layout>
+void treePass(Layout& layout, uint64_t seed, int chunkX) {
+    const uint64_t spawnStream = HashRandom::streamKey(seed, RandomPurpose::TREE_SPAWN);
+
+    for (int x = 2; x < CHUNK_WIDTH - 2; x++) {
+        if (HashRandom::range(spawnStream, chunkX * CHUNK_WIDTH + x, 0, 0, 100) <= 92) continue;
+
+        for (int y = 0; y < WORLD_HEIGHT; y++) {
+            if (layout.get(x, y) != TileType::GRASS) continue;
+
+            int topY = y - 5;
+            for (int i = 1; i <= 5; i++) {
+                layout.set(x, y - i, TileType::TRUNK);
+            }
+            for (int lx = x - 2; lx <= x + 2; lx++) {
+                for (int ly = topY - 2; ly <= topY; ly++) {
+                    if (layout.get(lx, ly) == TileType::AIR) {
+                        layout.set(lx, ly, TileType::LEAVES);
+                    }
+                }
+            }
+            break;
+        }
+    }
+}
+
+// A simplified mesh pass: one quad per non-air tile, with no culling or fill
+template <typename Layout>
+size_t meshPass(const Layout& layout, sf::VertexArray& vertices) {
+    vertices.clear();
+    const float size = static_cast<float>(TILE_SIZE);
+
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        for (int y = 0; y < WORLD_HEIGHT; y++) {
+            if (layout.get(x, y) != TileType::AIR) {
+                float left = x * size;
+                float top = y * size;
+                vertices.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(0.0f, 0.0f)));
+                vertices.append(sf::Vertex(sf::Vector2f(left + size, top), sf::Vector2f(128.0f, 0.0f)));
+                vertices.append(sf::Vertex(sf::Vector2f(left + size, top + size), sf::Vector2f(128.0f, 128.0f)));
+                vertices.append(sf::Vertex(sf::Vector2f(left, top + size), sf::Vector2f(0.0f, 128.0f)));
+            }
+        }
+    }
+    return vertices.getVertexCount() / 4;
+}
+
+struct PassTimes {
+    double terrain = 0.0;
+    double trees = 0.0;
+    double mesh = 0.0;
+    size_t checksum = 0;
+};
+
+template <typename Layout>
+PassTimes runLayout(int iterations, const PerlinNoise& noise, uint64_t seed) {
+    using Clock = std::chrono::high_resolution_clock;
+    PassTimes times;
+    Layout layout;
+    sf::VertexArray vertices(sf::Quads);
+
+    for (int i = 0; i < iterations; i++) {
+        int chunkX = i % 62500;
+        layout.clear();
+
+        auto t0 = Clock::now();
+        terrainPass(layout, noise, seed, chunkX);
+        auto t1 = Clock::now();
+        treePass(layout, seed, chunkX);
+        auto t2 = Clock::now();
+        times.checksum += meshPass(layout, vertices);
+        auto t3 = Clock::now();
+
+        times.terrain += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        times.trees += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        times.mesh += std::chrono::duration<double, std::micro>(t3 - t2).count();
+    }
+
+    times.terrain /= iterations;
+    times.trees /= iterations;
+    times.mesh /= iterations;
+    return times;
+}
+
+// Stone variant selection for a full chunk of stone: one mt19937 draw per tile
+// (the old generator) against one position hash per tile
+void printRngComparison(int iterations, uint64_t seed) {
+    using Clock = std::chrono::high_resolution_clock;
+    std::vector<TileType> tiles(CHUNK_WIDTH * WORLD_HEIGHT);
+    size_t graveled = 0;
+
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        std::mt19937 rng(seed + i);
+        std::uniform_int_distribution<int> stoneDist(0, 1);
+        for (TileType& tile : tiles) {
+            tile = stoneDist(rng) == 0 ? TileType::STONE : TileType::GRAVELED_STONE;
+        }
+        graveled += tiles[i % tiles.size()] == TileType::GRAVELED_STONE;
+    }
+    double mt = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+
+    start = Clock::now();
+    const uint64_t stream = HashRandom::streamKey(seed, RandomPurpose::STONE_VARIANT);
+    for (int i = 0; i < iterations; i++) {
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            for (int y = 0; y < WORLD_HEIGHT; y++) {
+                tiles[x * WORLD_HEIGHT + y] = HashRandom::coin(stream, i * CHUNK_WIDTH + x, y) ? 
+                                              TileType::GRAVELED_STONE : TileType::STONE;
+            }
+        }
+        graveled += tiles[i % tiles.size()] == TileType::GRAVELED_STONE;
+    }
+    double hashed = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+
+    std::cout << "  stone variant RNG: mt19937 " << mt << " us, hash " << hashed << " us, speedup "
+              << (hashed > 0.0 ? mt / hashed : 0.0) << "x (" << graveled << " samples graveled)" << std::endl;
+}
+
+void printRow(const char* name, double nested, double flat) {
+    std::cout << "  " << name << ": nested " << nested << " us, flat " << flat
+              << " us, speedup " << (flat > 0.0 ? nested / flat : 0.0) << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const uint64_t seed = (static_cast<uint64_t>(1) << 50) + 12345;
+
+    PerlinNoise noise(seed);
+
+    // Warm up both paths once so allocation and page faults don't skew results
+    runLayout<NestedLayout>(10, noise, seed);
+    runLayout<FlatLayout>(10, noise, seed);
+
+    PassTimes nested = runLayout<NestedLayout>(iterations, noise, seed);
+    PassTimes flat = runLayout<FlatLayout>(iterations, noise, seed);
+
+    std::cout << "Chunk layout benchmark (" << iterations << " chunks, "
+              << CHUNK_WIDTH << "x" << WORLD_HEIGHT << " tiles)" << std::endl;
+    printRow("generateTerrain", nested.terrain, flat.terrain);
+    printRow("generateTrees  ", nested.trees, flat.trees);
+    printRow("mesh building  ", nested.mesh, flat.mesh);
+    printRow("total          ", nested.terrain + nested.trees + nested.mesh,
+             flat.terrain + flat.trees + flat.mesh);
+    printRngComparison(iterations, seed);
+
+    if (nested.checksum != flat.checksum) {
+        std::cerr << "Layouts produced different tile counts!" << std::endl;
+        return 1;
+    }
+
+    // Full generation pipeline for reference
+    auto terrainNoise = std::make_shared<PerlinNoise>(seed);
+    SurfaceIndex surface(terrainNoise, WORLD_HEIGHT);
+    BiomeMap biomes(terrainNoise, WORLD_HEIGHT);
+    GenerationPipeline pipeline;
+    pipeline.addDefaultStages();
+    using Clock = std::chrono::high_resolution_clock;
+    size_t sectionCount = 0;
+    size_t uniformSections = 0;
+    size_t tileBytes = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        Chunk chunk(i % 62500, CHUNK_WIDTH, WORLD_HEIGHT);
+        pipeline.generate(chunk, surface, biomes, seed);
+        
+        for (int s = 0; s < chunk.getSectionCount(); s++) {
+            const ChunkSection& section = chunk.getSection(s);
+            sectionCount++;
+            uniformSections += section.isUniform() ? 1 : 0;
+            tileBytes += section.data.size();
+        }
+    }
+    double perChunk = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+    std::cout << "  full pipeline: " << perChunk << " us per chunk" << std::endl;
+    std::cout << "  sections: " << uniformSections << " of " << sectionCount << " uniform, "
+              << tileBytes / iterations << " tile bytes per chunk (flat: "
+              << CHUNK_WIDTH * WORLD_HEIGHT << ")" << std::endl;
+    pipeline.printReport(std::cout);
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+// Tile edit latency benchmark. Loads a stretch of world around a fixed point and times
+// how long an edit takes to reach the screen: the tile writes, the mesh (and bake)
+// update they cause and drawing the next frame into an off-screen target. Edits are
+// single mined tiles and round blasts, with section baking off and on. It then times
+// one chunk's mesh patched after a single-tile edit against rebuilding it from scratch.
+// Times are CPU side up to display(); the GPU may still be finishing the frame.
+//
+// Usage: edit_bench [edits] [blast radius]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include "../engine/HashRandom.h"
+#include "../render/ChunkMesh.h"
+#include "../render/TileManager.h"
+#include "../render/WorldRenderer.h"
+#include "../world/GenerationPipeline.h"
+#include "../world/World.h"
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+const int CHUNK_WIDTH = 16;
+const int WORLD_HEIGHT = 200;
+const int TILE_SIZE = 16;
+const uint64_t SEED = 123456789012ULL;
+const unsigned int VIEW_WIDTH = 1280;
+const unsigned int VIEW_HEIGHT = 720;
+
+double microsecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void printLatencies(const char* name, std::vector<double>& latencies, size_t sectionsRebuilt) {
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0.0;
+    for (double latency : latencies) {
+        total += latency;
+    }
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << "mean " << std::setw(8) << total / latencies.size() << " us, p50 " << std::setw(8)
+              << latencies[latencies.size() / 2] << " us, p99 " << std::setw(8)
+              << latencies[latencies.size() * 99 / 100] << " us, " << std::setprecision(2)
+              << static_cast<double>(sectionsRebuilt) / latencies.size() << " sections rebuilt per edit" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int editCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 500;
+    int radius = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+
+    WorldRenderer renderer("assets/textures/");
+    if (!renderer.loadTextures()) {
+        std::cerr << "Warning: textures missing, buried rock won't be filled" << std::endl;
+    }
+    sf::RenderTexture target;
+    if (!target.create(VIEW_WIDTH, VIEW_HEIGHT)) {
+        std::cerr << "Failed to create the off-screen render target" << std::endl;
+        return 1;
+    }
+
+    // View centred on the surface somewhere in the middle of the world
+    World world(WORLD_HEIGHT, TILE_SIZE, SEED);
+    const int centerTileX = world.getWorldWidth() / TILE_SIZE / 2;
+    const int surfaceY = world.getSurfaceY(centerTileX);
+    const sf::Vector2f center(static_cast<float>(centerTileX * TILE_SIZE), static_cast<float>(surfaceY * TILE_SIZE));
+    target.setView(sf::View(center, sf::Vector2f(static_cast<float>(VIEW_WIDTH), static_cast<float>(VIEW_HEIGHT))));
+    const float viewLeft = center.x - VIEW_WIDTH / 2.0f;
+    const float viewRight = center.x + VIEW_WIDTH / 2.0f;
+
+    // Wait for the chunks in view to generate, then draw a few frames to build their meshes
+    auto loadStart = Clock::now();
+    do {
+        world.update(viewLeft, viewRight);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } while ((world.getPendingChunkCount() > 0 || world.getActiveChunkCount() == 0) &&
+             microsecondsSince(loadStart) < 10e6);
+    for (int i = 0; i < 3; i++) {
+        renderer.draw(target, world);
+        target.display();
+    }
+
+    std::cout << "Edit latency benchmark (" << editCount << " edits, blast radius " << radius << ", "
+              << world.getActiveChunkCount() << " chunks loaded)" << std::endl;
+
+    // Edit sites anywhere on screen from a little above the surface down, the same for every run
+    const int viewTilesX = static_cast<int>(VIEW_WIDTH) / TILE_SIZE;
+    const int viewTilesY = static_cast<int>(VIEW_HEIGHT) / TILE_SIZE;
+    std::vector<sf::Vector2i> sites(editCount);
+    uint64_t state = SEED;
+    for (sf::Vector2i& site : sites) {
+        state = HashRandom::mix(state);
+        site.x = centerTileX - viewTilesX / 2 + static_cast<int>(state % viewTilesX);
+        site.y = std::min(WORLD_HEIGHT - 2, surfaceY - 4 + static_cast<int>((state >> 32) % (viewTilesY / 2 + 4)));
+    }
+
+    // A frame with nothing edited, for reference
+    std::vector<double> idle;
+    for (int i = 0; i < editCount; i++) {
+        auto start = Clock::now();
+        renderer.draw(target, world);
+        target.display();
+        idle.push_back(microsecondsSince(start));
+    }
+    printLatencies("no edit", idle, 0);
+
+    // Tiles a disc of radius r around a site covers, in a fixed order
+    auto discAround = [](const sf::Vector2i& site, int r) {
+        std::vector<sf::Vector2i> tiles;
+        for (int dx = -r; dx <= r; dx++) {
+            for (int dy = -r; dy <= r; dy++) {
+                if (dx * dx + dy * dy <= r * r) {
+                    tiles.emplace_back(site.x + dx, site.y + dy);
+                }
+            }
+        }
+        return tiles;
+    };
+
+    // Mining digs single tiles out and blasting clears a disc. After each run the dug tiles
+    // are put back in reverse order, so every run starts from the same world.
+    for (bool baking : {false, true}) {
+        renderer.setBakingEnabled(baking);
+        for (int r : {0, radius}) {
+            std::vector<TileType> dug;
+            std::vector<double> latencies;
+            size_t rebuilt = 0;
+            for (const sf::Vector2i& site : sites) {
+                auto start = Clock::now();
+                for (const sf::Vector2i& tile : discAround(site, r)) {
+                    dug.push_back(world.getTile(tile.x, tile.y));
+                    world.setTile(tile.x, tile.y, TileType::AIR);
+                }
+                renderer.draw(target, world);
+                target.display();
+                latencies.push_back(microsecondsSince(start));
+                rebuilt += renderer.getSectionsRebuilt();
+            }
+            std::string name = std::string(r == 0 ? "mine" : "blast") + (baking ? ", baked" : "");
+            printLatencies(name.c_str(), latencies, rebuilt);
+
+            for (auto site = sites.rbegin(); site != sites.rend(); ++site) {
+                std::vector<sf::Vector2i> tiles = discAround(*site, r);
+                for (auto tile = tiles.rbegin(); tile != tiles.rend(); ++tile) {
+                    world.setTile(tile->x, tile->y, dug.back());
+                    dug.pop_back();
+                }
+            }
+            renderer.draw(target, world);
+            target.display();
+        }
+    }
+
+    // One chunk's mesh after a single-tile edit: patched in place versus rebuilt. The two
+    // must come out identical.
+    GenerationPipeline pipeline;
+    pipeline.addDefaultStages();
+    auto noise = std::make_shared<PerlinNoise>(SEED);
+    SurfaceIndex surface(noise, WORLD_HEIGHT);
+    BiomeMap biomes(noise, WORLD_HEIGHT);
+    Chunk chunk(centerTileX / CHUNK_WIDTH, CHUNK_WIDTH, WORLD_HEIGHT);
+    pipeline.generate(chunk, surface, biomes, SEED);
+
+    const TileManager& tileManager = renderer.getTileManager();
+    ChunkMesh patched;
+    ChunkMesh rebuilt;
+    patched.build(chunk, tileManager, TILE_SIZE);
+    rebuilt.build(chunk, tileManager, TILE_SIZE);
+    double patchTime = 0.0;
+    double rebuildTime = 0.0;
+    int mismatches = 0;
+    for (int i = 0; i < editCount; i++) {
+        const sf::Vector2i& site = sites[i];
+        const int x = site.x & (CHUNK_WIDTH - 1);
+        chunk.setTile(x, site.y, chunk.getTile(x, site.y) == TileType::AIR ? TileType::STONE : TileType::AIR);
+
+        auto start = Clock::now();
+        patched.update(chunk, tileManager, TILE_SIZE);
+        patchTime += microsecondsSince(start);
+
+        start = Clock::now();
+        rebuilt.build(chunk, tileManager, TILE_SIZE);
+        rebuildTime += microsecondsSince(start);
+
+        if (!patched.matches(rebuilt)) {
+            mismatches++;
+        }
+    }
+    std::cout << std::fixed << std::setprecision(2) << "  mesh after one edit:  patched "
+              << patchTime / editCount << " us, rebuilt " << rebuildTime / editCount << " us ("
+              << patched.getQuadCount() << " quads, " << mismatches << " differ)"
+              << (mismatches == 0 ? "" : "  MISMATCH") << std::endl;
+
+    if (mismatches > 0) {
+        std::cerr << "Patched meshes differ from rebuilt ones!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Headless world generation benchmark. Generates a run of chunks for several seeds
+// through the same worker pool and generation pipeline the game uses, without opening
+// a window, and reports throughput, per-stage timing, memory per chunk and a content
+// hash. The hash only depends on the seeds and chunk count, so it must not change
+// with the thread count - compare it across runs to catch nondeterminism.
+//
+// Usage: worldgen_bench [chunks] [seeds] [threads]   (threads 0 = one per core)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../engine/HashRandom.h"
+#include "../engine/PerlinNoise.h"
+#include "../world/BiomeMap.h"
+#include "../world/ChunkGenerator.h"
+#include "../world/SurfaceIndex.h"
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+const int CHUNK_WIDTH = 16;
+const int WORLD_HEIGHT = 200;
+
+// FNV-1a over a chunk's tiles and the writes it made into its neighbours
+uint64_t hashChunk(const Chunk& chunk, const std::vector<TileWrite>& overflow) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    for (int x = 0; x < chunk.getWidth(); x++) {
+        for (int y = 0; y < chunk.getHeight(); y++) {
+            add(static_cast<uint64_t>(chunk.getTile(x, y)));
+        }
+    }
+    for (const TileWrite& write : overflow) {
+        add(static_cast<uint32_t>(write.worldX));
+        add(static_cast<uint32_t>(write.y));
+        add(static_cast<uint64_t>(write.type));
+    }
+    return hash;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int chunkCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    int seedCount = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::max(0, std::atoi(argv[3]))) : 0;
+
+    ChunkGenerator generator(CHUNK_WIDTH, WORLD_HEIGHT, threads);
+
+    std::cout << "World generation benchmark (" << chunkCount << " chunks x " << seedCount
+              << " seeds, " << generator.getThreadCount() << " threads, noise kernel "
+              << PerlinNoise::getKernelName(PerlinNoise::getKernel()) << ")" << std::endl;
+
+    uint64_t contentHash = 0;
+    double totalSeconds = 0.0;
+    size_t totalMemory = 0;
+
+    for (int s = 0; s < seedCount; s++) {
+        // Large seeds like the game uses, but fixed so runs can be compared
+        const uint64_t seed = (static_cast<uint64_t>(1) << 50) + HashRandom::mix(s + 1) % (static_cast<uint64_t>(1) << 59);
+        auto terrainNoise = std::make_shared<PerlinNoise>(seed);
+        auto surface = std::make_shared<SurfaceIndex>(terrainNoise, WORLD_HEIGHT);
+        auto biomes = std::make_shared<BiomeMap>(terrainNoise, WORLD_HEIGHT);
+
+        // Hashes are kept per chunk and folded in chunk order, so the result
+        // doesn't depend on which worker finished first
+        std::vector<uint64_t> chunkHashes(chunkCount);
+        size_t memory = 0;
+        int received = 0;
+
+        auto start = Clock::now();
+        for (int x = 0; x < chunkCount; x++) {
+            generator.request(x, static_cast<uint64_t>(s), surface, biomes, seed);
+        }
+        while (received < chunkCount) {
+            size_t collected = generator.collect([&](ChunkGenerator::Result&& result) {
+                int chunkX = result.chunk->getChunkX();
+                chunkHashes[chunkX] = hashChunk(*result.chunk, result.overflow);
+                memory += result.chunk->getMemoryUsage();
+                received++;
+            });
+            if (collected == 0) {
+                std::this_thread::yield();
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        uint64_t seedHash = seed;
+        for (uint64_t chunkHash : chunkHashes) {
+            seedHash = HashRandom::mix(seedHash ^ chunkHash);
+        }
+        contentHash = HashRandom::mix(contentHash ^ seedHash);
+        totalSeconds += seconds;
+        totalMemory += memory;
+
+        std::cout << "  seed " << seed << ": " << chunkCount / seconds << " chunks/s, hash "
+                  << std::hex << seedHash << std::dec << std::endl;
+    }
+
+    const size_t generated = static_cast<size_t>(chunkCount) * seedCount;
+    std::cout << "Total: " << generated / totalSeconds << " chunks/s, "
+              << totalMemory / generated / 1024.0 << " KB per chunk" << std::endl;
+    generator.getPipeline().printReport(std::cout);
+    std::cout << "Content hash: " << std::hex << std::setw(16) << std::setfill('0') << contentHash
+              << std::dec << std::endl;
+
+    return 0;
+}
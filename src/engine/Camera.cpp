@@ -5,7 +5,8 @@ Camera::Camera(int vpWidth, int vpHeight, int wWidth, int wHeight) :
     viewportHeight(vpHeight),
     worldWidth(wWidth),
     worldHeight(wHeight),
-    moveSpeed(500.0f) {
+    moveSpeed(500.0f),
+    velocity(0.0f, 0.0f) {
     
     // Initialize view with a closer zoom (smaller size = closer zoom)
     view.setSize(static_cast<float>(vpWidth) * 0.7f, static_cast<float>(vpHeight) * 0.7f);
@@ -18,9 +19,12 @@ float Camera::applyBoundary(float value, float viewportDimension, float worldDim
 }
 
 void Camera::move(float dx, float dy, float dt) {
+    // Remember the requested velocity so the world can prefetch ahead of the camera
+    velocity = sf::Vector2f(dx * moveSpeed, dy * moveSpeed);
+    
     // Calculate new position with delta time
-    float newX = view.getCenter().x + dx * moveSpeed * dt;
-    float newY = view.getCenter().y + dy * moveSpeed * dt;
+    float newX = view.getCenter().x + velocity.x * dt;
+    float newY = view.getCenter().y + velocity.y * dt;
     
     // Apply bounds checking using the helper function
     newX = applyBoundary(newX, viewportWidth, worldWidth);
@@ -49,6 +53,8 @@ void Camera::setCreativeMode(bool isCreative) {
 }
 
 void Camera::reset() {
+    velocity = sf::Vector2f(0.0f, 0.0f);
+    
     // Center horizontally but position vertically to see more of the surface
     view.setCenter(worldWidth / 2.0f, worldHeight / 3.0f);
     // Reset zoom to closer default view
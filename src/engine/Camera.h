@@ -10,6 +10,7 @@ private:
     int viewportWidth, viewportHeight;
     int worldWidth, worldHeight;
     float moveSpeed;
+    sf::Vector2f velocity;   // World units per second from the last move() call
     
     // Helper method to keep coordinates within world boundaries
     float applyBoundary(float value, float viewportDimension, float worldDimension) const;
@@ -17,7 +18,10 @@ private:
 public:
     Camera(int vpWidth, int vpHeight, int wWidth, int wHeight);
     void move(float dx, float dy, float dt);
+    void stop() { velocity = sf::Vector2f(0.0f, 0.0f); }
     void setSpeed(float speed);
+    float getSpeed() const { return moveSpeed; }
+    const sf::Vector2f& getVelocity() const { return velocity; }
     void zoom(float factor);
     const sf::View& getView() const;
     void setCreativeMode(bool isCreative);
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+// What a random value is used for. Each purpose gets an independent stream, so
+// adding a new feature never shifts the values an existing one sees.
+enum class RandomPurpose : uint32_t {
+    STONE_VARIANT,
+    TREE_SPAWN,
+    TREE_HEIGHT,
+    LEAF_CORNER,
+    ORE_VEIN,
+    ORE_SHAPE
+};
+
+// Stateless counter-based random numbers for world generation.
+// Every value is a SplitMix64 hash of (seed, worldX, y, purpose), so tiles can be
+// generated in any order or in parallel and still come out the same.
+class HashRandom {
+public:
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    // SplitMix64 finalizer: a bijective mix of all 64 bits
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Per-(seed, purpose) stream key; loop-invariant, so hoist it out of hot loops
+    static uint64_t streamKey(uint64_t seed, RandomPurpose purpose) {
+        return mix(seed + GOLDEN_GAMMA * (static_cast<uint64_t>(purpose) + 1));
+    }
+
+    static uint64_t hash(uint64_t stream, int x, int y) {
+        uint64_t position = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+        return mix(stream ^ (position * 0xD6E8FEB86659FD93ULL));
+    }
+
+    static uint64_t hash(uint64_t seed, int x, int y, RandomPurpose purpose) {
+        return hash(streamKey(seed, purpose), x, y);
+    }
+
+    // Uniform integer in [min, max] from the top 32 bits (multiply-shift, no modulo)
+    static int range(uint64_t stream, int x, int y, int min, int max) {
+        uint64_t span = static_cast<uint64_t>(max - min) + 1;
+        return min + static_cast<int>(((hash(stream, x, y) >> 32) * span) >> 32);
+    }
+
+    static int range(uint64_t seed, int x, int y, RandomPurpose purpose, int min, int max) {
+        return range(streamKey(seed, purpose), x, y, min, max);
+    }
+
+    // Fair coin flip
+    static bool coin(uint64_t stream, int x, int y) {
+        return (hash(stream, x, y) >> 63) != 0;
+    }
+};
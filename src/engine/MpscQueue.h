@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Lock-free multi-producer / single-consumer queue.
+// Producers push with a single CAS onto an intrusive stack; the consumer takes
+// the whole stack in one atomic exchange and reverses it, so items come out in
+// the order they were pushed. Only one thread may call popAll().
+template <typename T>
+class MpscQueue {
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head;
+
+public:
+    MpscQueue() : head(nullptr) {}
+
+    ~MpscQueue() {
+        Node* node = head.exchange(nullptr, std::memory_order_acquire);
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Safe to call from any thread
+    void push(T value) {
+        Node* node = new Node{std::move(value), head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(node->next, node,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    // Consumer thread only: hands every queued item to fn in push order
+    template <typename Fn>
+    size_t popAll(Fn&& fn) {
+        Node* node = head.exchange(nullptr, std::memory_order_acquire);
+
+        // Reverse the stack to restore FIFO order
+        Node* ordered = nullptr;
+        while (node) {
+            Node* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+
+        size_t count = 0;
+        while (ordered) {
+            Node* next = ordered->next;
+            fn(std::move(ordered->value));
+            delete ordered;
+            ordered = next;
+            count++;
+        }
+        return count;
+    }
+
+    bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+};
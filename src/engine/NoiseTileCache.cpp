@@ -0,0 +1,239 @@
+#include "NoiseTileCache.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+// Tile coordinate containing a sample, rounding towards negative infinity
+int tileIndex(int sample) {
+    return sample >= 0 ? sample / NoiseTileCache::TILE_SIZE
+                       : -((-sample - 1) / NoiseTileCache::TILE_SIZE) - 1;
+}
+
+uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void hashCombine(size_t& hash, uint64_t value) {
+    hash ^= std::hash<uint64_t>()(value) + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+}
+
+} // namespace
+
+bool NoiseTileCache::Key::operator==(const Key& other) const {
+    return seed == other.seed && tileX == other.tileX && tileY == other.tileY &&
+           settings.scale == other.settings.scale &&
+           settings.octaves == other.settings.octaves &&
+           settings.persistence == other.settings.persistence &&
+           settings.lacunarity == other.settings.lacunarity &&
+           settings.offsetX == other.settings.offsetX &&
+           settings.offsetY == other.settings.offsetY;
+}
+
+size_t NoiseTileCache::KeyHash::operator()(const Key& key) const {
+    size_t hash = std::hash<uint64_t>()(key.seed);
+    hashCombine(hash, floatBits(key.settings.scale));
+    hashCombine(hash, static_cast<uint64_t>(key.settings.octaves));
+    hashCombine(hash, floatBits(key.settings.persistence));
+    hashCombine(hash, floatBits(key.settings.lacunarity));
+    hashCombine(hash, floatBits(key.settings.offsetX));
+    hashCombine(hash, floatBits(key.settings.offsetY));
+    hashCombine(hash, (static_cast<uint64_t>(static_cast<uint32_t>(key.tileX)) << 32) |
+                      static_cast<uint32_t>(key.tileY));
+    return hash;
+}
+
+NoiseTileCache::NoiseTileCache(size_t budgetBytes) :
+    budgetBytes(budgetBytes),
+    usedBytes(0),
+    hits(0),
+    misses(0),
+    evictions(0) {
+}
+
+std::shared_ptr<const NoiseTileCache::Tile> NoiseTileCache::lookup(const Key& key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return nullptr;
+    }
+
+    // Move to the front as most recently used
+    entries.splice(entries.begin(), entries, it->second);
+    hits++;
+    return it->second->tile;
+}
+
+void NoiseTileCache::insert(const Key& key, std::shared_ptr<const Tile> tile) {
+    // Another caller may have generated the same tile in the meantime
+    if (index.find(key) != index.end()) {
+        return;
+    }
+
+    usedBytes += tile->size() * sizeof(float);
+    entries.push_front(Entry{key, std::move(tile)});
+    index[key] = entries.begin();
+
+    evictToBudget();
+}
+
+void NoiseTileCache::evictToBudget() {
+    // Drop least recently used tiles until we fit. Callers still holding a tile keep it alive.
+    while (usedBytes > budgetBytes && !entries.empty()) {
+        const Entry& oldest = entries.back();
+        usedBytes -= oldest.tile->size() * sizeof(float);
+        index.erase(oldest.key);
+        entries.pop_back();
+        evictions++;
+    }
+}
+
+std::shared_ptr<const NoiseTileCache::Tile> NoiseTileCache::generateTile(const PerlinNoise& noise, const Key& key) {
+    auto tile = std::make_shared<Tile>(static_cast<size_t>(TILE_SIZE) * TILE_SIZE);
+    noise.generateNoiseRegion(tile->data(), key.tileX * TILE_SIZE, key.tileY * TILE_SIZE,
+                              TILE_SIZE, TILE_SIZE, key.settings, 1);
+    return tile;
+}
+
+std::shared_ptr<const NoiseTileCache::Tile> NoiseTileCache::getTile(const PerlinNoise& noise,
+                                                                    const NoiseMapSettings& settings,
+                                                                    int tileX, int tileY) {
+    Key key = {noise.getSeed(), settings, tileX, tileY};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (std::shared_ptr<const Tile> tile = lookup(key)) {
+            return tile;
+        }
+    }
+
+    // Generate outside the lock so other callers aren't blocked
+    std::shared_ptr<const Tile> tile = generateTile(noise, key);
+    std::lock_guard<std::mutex> lock(mutex);
+    insert(key, tile);
+    return tile;
+}
+
+void NoiseTileCache::getRegion(const PerlinNoise& noise, const NoiseMapSettings& settings,
+                               int originX, int originY, int width, int height, float* out,
+                               unsigned threadCount) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    int firstTileX = tileIndex(originX);
+    int firstTileY = tileIndex(originY);
+    int tilesX = tileIndex(originX + width - 1) - firstTileX + 1;
+    int tilesY = tileIndex(originY + height - 1) - firstTileY + 1;
+
+    // Look up every tile the region touches, remembering which ones are missing
+    std::vector<Key> keys;
+    std::vector<std::shared_ptr<const Tile>> tiles(static_cast<size_t>(tilesX) * tilesY);
+    std::vector<size_t> missing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int ty = 0; ty < tilesY; ty++) {
+            for (int tx = 0; tx < tilesX; tx++) {
+                keys.push_back(Key{noise.getSeed(), settings, firstTileX + tx, firstTileY + ty});
+                tiles[keys.size() - 1] = lookup(keys.back());
+                if (!tiles[keys.size() - 1]) {
+                    missing.push_back(keys.size() - 1);
+                }
+            }
+        }
+    }
+
+    // Generate the missing tiles, one tile per task
+    if (!missing.empty()) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadCount = std::min(threadCount, static_cast<unsigned>(missing.size()));
+
+        std::atomic<size_t> next(0);
+        auto work = [&]() {
+            for (size_t i = next++; i < missing.size(); i = next++) {
+                tiles[missing[i]] = generateTile(noise, keys[missing[i]]);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threadCount; t++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i : missing) {
+            insert(keys[i], tiles[i]);
+        }
+    }
+
+    // Copy the overlapping part of each tile into the output rows
+    for (int ty = 0; ty < tilesY; ty++) {
+        int tileTop = (firstTileY + ty) * TILE_SIZE;
+        int rowBegin = std::max(originY, tileTop);
+        int rowEnd = std::min(originY + height, tileTop + TILE_SIZE);
+
+        for (int tx = 0; tx < tilesX; tx++) {
+            const Tile& tile = *tiles[static_cast<size_t>(ty) * tilesX + tx];
+            int tileLeft = (firstTileX + tx) * TILE_SIZE;
+            int colBegin = std::max(originX, tileLeft);
+            int colEnd = std::min(originX + width, tileLeft + TILE_SIZE);
+
+            for (int y = rowBegin; y < rowEnd; y++) {
+                const float* src = &tile[static_cast<size_t>(y - tileTop) * TILE_SIZE + (colBegin - tileLeft)];
+                float* dst = out + static_cast<size_t>(y - originY) * width + (colBegin - originX);
+                std::copy(src, src + (colEnd - colBegin), dst);
+            }
+        }
+    }
+}
+
+void NoiseTileCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    usedBytes = 0;
+}
+
+void NoiseTileCache::setBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    budgetBytes = bytes;
+    evictToBudget();
+}
+
+size_t NoiseTileCache::getBudget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return budgetBytes;
+}
+
+size_t NoiseTileCache::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+size_t NoiseTileCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+uint64_t NoiseTileCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+uint64_t NoiseTileCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+uint64_t NoiseTileCache::getEvictions() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return evictions;
+}
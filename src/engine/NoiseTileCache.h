@@ -0,0 +1,84 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <vector>
+#include "PerlinNoise.h"
+
+// Shared LRU cache of fixed-size noise map tiles.
+// Tiles are keyed by (seed, octave settings, tile coordinates), so every caller asking
+// for the same area with the same configuration reuses the stored samples instead of
+// recomputing them. Safe to share between threads.
+class NoiseTileCache {
+public:
+    static const int TILE_SIZE = 128;
+    static const size_t DEFAULT_BUDGET_BYTES = 16 * 1024 * 1024;
+
+    // TILE_SIZE * TILE_SIZE samples, row-major
+    using Tile = std::vector<float>;
+
+private:
+    struct Key {
+        unsigned long long seed;
+        NoiseMapSettings settings;
+        int tileX;
+        int tileY;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<const Tile> tile;
+    };
+
+    // Most recently used tile at the front
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    mutable std::mutex mutex;
+
+    size_t budgetBytes;
+    size_t usedBytes;
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+
+    // Both expect the mutex to be held
+    std::shared_ptr<const Tile> lookup(const Key& key);
+    void insert(const Key& key, std::shared_ptr<const Tile> tile);
+    void evictToBudget();
+
+    static std::shared_ptr<const Tile> generateTile(const PerlinNoise& noise, const Key& key);
+
+public:
+    NoiseTileCache(size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+
+    // Return one tile, generating and storing it on a miss
+    std::shared_ptr<const Tile> getTile(const PerlinNoise& noise, const NoiseMapSettings& settings,
+                                        int tileX, int tileY);
+
+    // Fill a row-major buffer (index y * width + x) with the region whose top-left sample
+    // is (originX, originY). Matches PerlinNoise::generateNoiseRegion bit for bit.
+    // Missing tiles are generated across threadCount threads (0 = one per core).
+    void getRegion(const PerlinNoise& noise, const NoiseMapSettings& settings,
+                   int originX, int originY, int width, int height, float* out,
+                   unsigned threadCount = 0);
+
+    void clear();
+    void setBudget(size_t bytes);
+
+    size_t getBudget() const;
+    size_t getMemoryUsage() const;
+    size_t size() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    uint64_t getEvictions() const;
+};
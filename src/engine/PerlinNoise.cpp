@@ -1,4 +1,197 @@
 #include "PerlinNoise.h"
+#include "HashRandom.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PERLIN_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Samples handled per pass by the batched octave and noise map loops
+const size_t NOISE_BATCH = 256;
+
+// Noise maps smaller than this are generated on the calling thread
+const size_t MIN_PARALLEL_SAMPLES = 64 * 1024;
+
+// Octave offset in [-10000, 10000) for one (seed, index) pair, from a SplitMix64 hash
+float offsetFromSeed(unsigned long long seed, int index) {
+    uint64_t z = HashRandom::mix(seed + HashRandom::GOLDEN_GAMMA * static_cast<uint64_t>(index + 1));
+    
+    // Top 24 bits give an exactly representable fraction in [0, 1)
+    float unit = static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+    return unit * 20000.0f - 10000.0f;
+}
+
+NoiseKernel detectKernel() {
+#ifdef PERLIN_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return NoiseKernel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return NoiseKernel::SSE2;
+    }
+#endif
+    return NoiseKernel::SCALAR;
+}
+
+std::atomic<NoiseKernel> activeKernel(detectKernel());
+
+#ifdef PERLIN_X86_KERNELS
+// The SIMD kernels mirror PerlinNoise::noise operation for operation (same fastFloor,
+// fade, lerp and gradient selection, no fused multiply-add) so the results match the
+// scalar path bit for bit.
+
+__attribute__((target("sse2")))
+inline __m128 fade4(__m128 t) {
+    __m128 t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+    __m128 inner = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+    return _mm_mul_ps(t3, _mm_add_ps(_mm_mul_ps(t, inner), _mm_set1_ps(10.0f)));
+}
+
+__attribute__((target("sse2")))
+inline __m128 lerp4(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+__attribute__((target("sse2")))
+inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__attribute__((target("sse2")))
+inline __m128 grad4(__m128i hash, __m128 x, __m128 y) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+    __m128 u = select4(_mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8))), x, y);
+    __m128 useX = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                                                _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+    __m128 v = select4(_mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4))), y, _mm_and_ps(useX, x));
+    __m128 signU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+    __m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+    return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+}
+
+// SSE2 has no gather, so the permutation lookups are done per lane
+__attribute__((target("sse2")))
+size_t noiseSse2(const int* p, const float* xs, const float* ys, float* out, size_t n) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i mask255 = _mm_set1_epi32(255);
+    alignas(16) int X[4], Y[4], hashes[4][4];
+    
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        
+        // fastFloor: truncate, then step down unless the value is positive
+        __m128i fx = _mm_add_epi32(_mm_cvttps_epi32(x), _mm_castps_si128(_mm_cmpngt_ps(x, zero)));
+        __m128i fy = _mm_add_epi32(_mm_cvttps_epi32(y), _mm_castps_si128(_mm_cmpngt_ps(y, zero)));
+        __m128 xm = _mm_sub_ps(x, _mm_cvtepi32_ps(fx));
+        __m128 ym = _mm_sub_ps(y, _mm_cvtepi32_ps(fy));
+        
+        _mm_store_si128(reinterpret_cast<__m128i*>(X), _mm_and_si128(fx, mask255));
+        _mm_store_si128(reinterpret_cast<__m128i*>(Y), _mm_and_si128(fy, mask255));
+        for (int lane = 0; lane < 4; lane++) {
+            int A = p[X[lane]] + Y[lane];
+            int B = p[X[lane] + 1] + Y[lane];
+            hashes[0][lane] = p[p[A]];
+            hashes[1][lane] = p[p[B]];
+            hashes[2][lane] = p[p[A + 1]];
+            hashes[3][lane] = p[p[B + 1]];
+        }
+        
+        __m128 u = fade4(xm);
+        __m128 v = fade4(ym);
+        __m128 xm1 = _mm_sub_ps(xm, one);
+        __m128 ym1 = _mm_sub_ps(ym, one);
+        
+        __m128 gAA = grad4(_mm_load_si128(reinterpret_cast<const __m128i*>(hashes[0])), xm, ym);
+        __m128 gBA = grad4(_mm_load_si128(reinterpret_cast<const __m128i*>(hashes[1])), xm1, ym);
+        __m128 gAB = grad4(_mm_load_si128(reinterpret_cast<const __m128i*>(hashes[2])), xm, ym1);
+        __m128 gBB = grad4(_mm_load_si128(reinterpret_cast<const __m128i*>(hashes[3])), xm1, ym1);
+        
+        _mm_storeu_ps(out + i, lerp4(lerp4(gAA, gBA, u), lerp4(gAB, gBB, u), v));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline __m256 fade8(__m256 t) {
+    __m256 t3 = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+    __m256 inner = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f));
+    return _mm256_mul_ps(t3, _mm256_add_ps(_mm256_mul_ps(t, inner), _mm256_set1_ps(10.0f)));
+}
+
+__attribute__((target("avx2")))
+inline __m256 lerp8(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+__attribute__((target("avx2")))
+inline __m256 grad8(__m256i hash, __m256 x, __m256 y) {
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+    __m256 u = _mm256_blendv_ps(y, x, _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h)));
+    __m256 useX = _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)),
+                                                      _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+    __m256 v = _mm256_blendv_ps(_mm256_and_ps(useX, x), y,
+                                _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h)));
+    __m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+    __m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+    return _mm256_add_ps(_mm256_xor_ps(u, signU), _mm256_xor_ps(v, signV));
+}
+
+__attribute__((target("avx2")))
+size_t noiseAvx2(const int* p, const float* xs, const float* ys, float* out, size_t n) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i mask255 = _mm256_set1_epi32(255);
+    const __m256i oneI = _mm256_set1_epi32(1);
+    
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 y = _mm256_loadu_ps(ys + i);
+        
+        // fastFloor: truncate, then step down unless the value is positive
+        __m256i fx = _mm256_add_epi32(_mm256_cvttps_epi32(x),
+                                      _mm256_castps_si256(_mm256_cmp_ps(x, zero, _CMP_NGT_UQ)));
+        __m256i fy = _mm256_add_epi32(_mm256_cvttps_epi32(y),
+                                      _mm256_castps_si256(_mm256_cmp_ps(y, zero, _CMP_NGT_UQ)));
+        __m256 xm = _mm256_sub_ps(x, _mm256_cvtepi32_ps(fx));
+        __m256 ym = _mm256_sub_ps(y, _mm256_cvtepi32_ps(fy));
+        
+        __m256i X = _mm256_and_si256(fx, mask255);
+        __m256i Y = _mm256_and_si256(fy, mask255);
+        __m256i A = _mm256_add_epi32(_mm256_i32gather_epi32(p, X, 4), Y);
+        __m256i B = _mm256_add_epi32(_mm256_i32gather_epi32(p, _mm256_add_epi32(X, oneI), 4), Y);
+        __m256i hAA = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, A, 4), 4);
+        __m256i hBA = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, B, 4), 4);
+        __m256i hAB = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, _mm256_add_epi32(A, oneI), 4), 4);
+        __m256i hBB = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, _mm256_add_epi32(B, oneI), 4), 4);
+        
+        __m256 u = fade8(xm);
+        __m256 v = fade8(ym);
+        __m256 xm1 = _mm256_sub_ps(xm, one);
+        __m256 ym1 = _mm256_sub_ps(ym, one);
+        
+        __m256 gAA = grad8(hAA, xm, ym);
+        __m256 gBA = grad8(hBA, xm1, ym);
+        __m256 gAB = grad8(hAB, xm, ym1);
+        __m256 gBB = grad8(hBB, xm1, ym1);
+        
+        _mm256_storeu_ps(out + i, lerp8(lerp8(gAA, gBA, u), lerp8(gAB, gBB, u), v));
+    }
+    return i;
+}
+#endif
+
+} // namespace
 
 PerlinNoise::PerlinNoise(unsigned long long seed) {
     reseed(seed);
@@ -6,6 +199,7 @@ PerlinNoise::PerlinNoise(unsigned long long seed) {
 
 void PerlinNoise::reseed(unsigned long long newSeed) {
     newSeed = std::max(1000000000ULL, std::min(newSeed, 100000000000ULL));
+    seed = newSeed;
     
     p.resize(512);
     std::vector<int> source(256);
@@ -35,50 +229,60 @@ int PerlinNoise::fastFloor(float x) const {
     return x > 0 ? static_cast<int>(x) : static_cast<int>(x) - 1;
 }
 
-float PerlinNoise::grad(int hash, float x, float y, float z) const {
+float PerlinNoise::grad(int hash, float x, float y) const {
     int h = hash & 15;
     float u = h < 8 ? x : y;
-    float v = h < 4 ? y : (h == 12 || h == 14) ? x : z;
+    float v = h < 4 ? y : (h == 12 || h == 14) ? x : 0.0f;
     return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 }
 
 float PerlinNoise::noise(float x, float y) const {
-    const float z = 0.0f;
+    // Find unit square that contains the point
+    int floorX = fastFloor(x);
+    int floorY = fastFloor(y);
+    int X = floorX & 255;
+    int Y = floorY & 255;
     
-    // Find unit cube that contains the point
-    int X = fastFloor(x) & 255;
-    int Y = fastFloor(y) & 255;
-    int Z = fastFloor(z) & 255;
+    // Relative position inside the square
+    float xm = x - floorX;
+    float ym = y - floorY;
     
-    // Create mutable copies for the coordinates
-    float xm = x - fastFloor(x);
-    float ym = y - fastFloor(y);
-    float zm = z - fastFloor(z);
-    
-    // Compute fade curves for each of x, y, z
+    // Compute fade curves for each of x, y
     float u = fade(xm);
     float v = fade(ym);
-    float w = fade(zm);
     
-    // Hash coordinates of the 8 cube corners
+    // Hash coordinates of the 4 square corners. This is the z = 0 slice of the
+    // 3D permutation: p has 512 entries, so p[p[A] + 256] == p[p[A]].
     int A = p[X] + Y;
-    int AA = p[A] + Z;
-    int AB = p[A + 1] + Z;
     int B = p[X + 1] + Y;
-    int BA = p[B] + Z;
-    int BB = p[B + 1] + Z;
     
-    // Add blended results from 8 corners of cube
-    float res = lerp(lerp(lerp(grad(p[AA], xm, ym, zm),
-                              grad(p[BA], xm - 1, ym, zm), u),
-                         lerp(grad(p[AB], xm, ym - 1, zm),
-                              grad(p[BB], xm - 1, ym - 1, zm), u), v),
-                    lerp(lerp(grad(p[AA + 1], xm, ym, zm - 1),
-                              grad(p[BA + 1], xm - 1, ym, zm - 1), u),
-                         lerp(grad(p[AB + 1], xm, ym - 1, zm - 1),
-                              grad(p[BB + 1], xm - 1, ym - 1, zm - 1), u), v), w);
+    // Add blended results from 4 corners of the square
+    return lerp(lerp(grad(p[p[A]], xm, ym),
+                     grad(p[p[B]], xm - 1, ym), u),
+                lerp(grad(p[p[A + 1]], xm, ym - 1),
+                     grad(p[p[B + 1]], xm - 1, ym - 1), u), v);
+}
+
+void PerlinNoise::noise(const float* xs, const float* ys, float* out, size_t n) const {
+    size_t done = 0;
+    
+#ifdef PERLIN_X86_KERNELS
+    switch (activeKernel.load(std::memory_order_relaxed)) {
+        case NoiseKernel::AVX2:
+            done = noiseAvx2(p.data(), xs, ys, out, n);
+            break;
+        case NoiseKernel::SSE2:
+            done = noiseSse2(p.data(), xs, ys, out, n);
+            break;
+        default:
+            break;
+    }
+#endif
     
-    return res;
+    // Scalar fallback and the tail that doesn't fill a whole vector
+    for (size_t i = done; i < n; i++) {
+        out[i] = noise(xs[i], ys[i]);
+    }
 }
 
 float PerlinNoise::octaveNoise(float x, float y, int octaves, float persistence) const {
@@ -98,72 +302,389 @@ float PerlinNoise::octaveNoise(float x, float y, int octaves, float persistence)
     return total / maxValue;
 }
 
-std::vector<std::vector<float>> PerlinNoise::generateNoiseMap(int width, int height, float scale,
-                                                             int octaves, float persistence, 
-                                                             float lacunarity, float offsetX, 
-                                                             float offsetY, bool seamless) const {
-    std::vector<std::vector<float>> noiseMap(width, std::vector<float>(height, 0.0f));
+void PerlinNoise::octaveNoise(const float* xs, const float* ys, float* out, size_t n, 
+                              int octaves, float persistence) const {
+    float sampleX[NOISE_BATCH];
+    float sampleY[NOISE_BATCH];
+    float values[NOISE_BATCH];
     
-    if (scale <= 0) {
-        scale = 0.0001f;
+    for (size_t start = 0; start < n; start += NOISE_BATCH) {
+        size_t count = std::min(NOISE_BATCH, n - start);
+        float* total = out + start;
+        std::fill(total, total + count, 0.0f);
+        
+        // Same accumulation order as the scalar octaveNoise
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+        for (int octave = 0; octave < octaves; ++octave) {
+            for (size_t i = 0; i < count; i++) {
+                sampleX[i] = xs[start + i] * frequency;
+                sampleY[i] = ys[start + i] * frequency;
+            }
+            noise(sampleX, sampleY, values, count);
+            for (size_t i = 0; i < count; i++) {
+                total[i] += values[i] * amplitude;
+            }
+            
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            total[i] /= maxValue;
+        }
     }
+}
+
+float PerlinNoise::caveNoise(float x, float y, float z, float worminess) const {
+    // Use multiple noise layers at different frequencies
+    float n1 = noise(x, y * worminess);
+    float n2 = noise(x * 2.0f, y * 2.0f * worminess) * 0.5f;
+    float n3 = noise(x * 4.0f, y * 4.0f * worminess) * 0.25f;
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> offsetDist(-10000.0f, 10000.0f);
+    // Use z parameter for additional dimension if needed
+    float zFactor = z * 0.1f;  // Reduce z influence
+    float n4 = noise(x + zFactor, y + zFactor) * 0.125f;
     
-    std::vector<float> octaveOffsets(octaves * 2);
-    for (int i = 0; i < octaves * 2; i += 2) {
-        octaveOffsets[i] = offsetDist(gen) + offsetX;
-        octaveOffsets[i + 1] = offsetDist(gen) + offsetY;
+    // Combine noise layers
+    float combinedNoise = n1 + n2 + n3 + n4;
+    
+    // Apply a transformation to create more tunnel-like structures
+    // This creates sharper transitions between cave and solid
+    return (std::tanh(combinedNoise * 2.0f - 1.0f) + 1.0f) * 0.5f;
+}
+
+void PerlinNoise::caveLayers(const float* xs, const float* ys, float z, float* out, size_t n,
+                             float worminess) const {
+    float sampleX[NOISE_BATCH];
+    float sampleY[NOISE_BATCH];
+    float values[NOISE_BATCH];
+    const float zFactor = z * 0.1f;
+    
+    // The first three layers of caveNoise, one batched call each, summed in the same
+    // order. x * 1.0f == x exactly, so the first layer needs no special case.
+    const float frequencies[] = {1.0f, 2.0f, 4.0f};
+    const float weights[] = {1.0f, 0.5f, 0.25f};
+    
+    for (size_t start = 0; start < n; start += NOISE_BATCH) {
+        size_t count = std::min(NOISE_BATCH, n - start);
+        float* total = out + start;
+        std::fill(total, total + count, 0.0f);
+        
+        for (int layer = 0; layer < 3; layer++) {
+            for (size_t i = 0; i < count; i++) {
+                sampleX[i] = xs[start + i] * frequencies[layer];
+                sampleY[i] = ys[start + i] * frequencies[layer] * worminess;
+            }
+            noise(sampleX, sampleY, values, count);
+            for (size_t i = 0; i < count; i++) {
+                total[i] += values[i] * weights[layer];
+            }
+        }
+        
+        // The z layer
+        for (size_t i = 0; i < count; i++) {
+            sampleX[i] = xs[start + i] + zFactor;
+            sampleY[i] = ys[start + i] + zFactor;
+        }
+        noise(sampleX, sampleY, values, count);
+        for (size_t i = 0; i < count; i++) {
+            total[i] += values[i] * 0.125f;
+        }
+    }
+}
+
+void PerlinNoise::caveNoise(const float* xs, const float* ys, float z, float* out, size_t n,
+                            float worminess) const {
+    caveLayers(xs, ys, z, out, n, worminess);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (std::tanh(out[i] * 2.0f - 1.0f) + 1.0f) * 0.5f;
+    }
+}
+
+size_t PerlinNoise::caveMask(const float* xs, const float* ys, float z, float threshold,
+                             uint8_t* carve, size_t n, float worminess) const {
+    // caveNoise only returns values in (0, 1)
+    if (threshold >= 1.0f || threshold < 0.0f) {
+        bool all = threshold < 0.0f;
+        std::fill(carve, carve + n, static_cast<uint8_t>(all));
+        return all ? n : 0;
     }
     
-    auto sampleNoise = [&](float x, float y) -> float {
-        float noise = 0.0f;
-        float amplitude = 1.0f;
-        float frequency = 1.0f;
-        float maxValue = 0.0f;
+    // (tanh(c * 2 - 1) + 1) / 2 > t  <=>  c > (atanh(2t - 1) + 1) / 2, up to rounding. Values
+    // within a band of the limit wide enough to cover that rounding are shaped exactly as
+    // caveNoise does, so the result always matches it. The shaping's slope at the limit is
+    // 1 - (2t - 1)^2; a few float ulps of output are well inside 1e-5 / slope of input.
+    const double centered = 2.0 * threshold - 1.0;
+    const float limit = static_cast<float>((std::atanh(centered) + 1.0) * 0.5);
+    const float band = static_cast<float>(1e-5 / (1.0 - centered * centered));
+    
+    float values[NOISE_BATCH];
+    size_t carved = 0;
+    for (size_t start = 0; start < n; start += NOISE_BATCH) {
+        size_t count = std::min(NOISE_BATCH, n - start);
+        caveLayers(xs + start, ys + start, z, values, count, worminess);
+        for (size_t i = 0; i < count; i++) {
+            if (std::abs(values[i] - limit) > band) {
+                carve[start + i] = values[i] > limit;
+            } else {
+                carve[start + i] = (std::tanh(values[i] * 2.0f - 1.0f) + 1.0f) * 0.5f > threshold;
+            }
+            carved += carve[start + i];
+        }
+    }
+    return carved;
+}
+
+NoiseKernel PerlinNoise::getKernel() {
+    return activeKernel.load(std::memory_order_relaxed);
+}
+
+bool PerlinNoise::setKernel(NoiseKernel kernel) {
+    if (!isKernelSupported(kernel)) {
+        return false;
+    }
+    activeKernel.store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+bool PerlinNoise::isKernelSupported(NoiseKernel kernel) {
+    switch (kernel) {
+        case NoiseKernel::SCALAR:
+            return true;
+#ifdef PERLIN_X86_KERNELS
+        case NoiseKernel::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case NoiseKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* PerlinNoise::getKernelName(NoiseKernel kernel) {
+    switch (kernel) {
+        case NoiseKernel::SSE2: return "SSE2";
+        case NoiseKernel::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+void PerlinNoise::generateNoiseRows(float* out, int originX, int originY, int width, int height,
+                                    int yBegin, int yEnd, const NoiseMapSettings& settings,
+                                    const float* offsets, bool seamless, NoiseRange& range) const {
+    // Rows are sampled in batches along x so each octave is one batched noise call
+    float sampleX[NOISE_BATCH];
+    float sampleY[NOISE_BATCH];
+    float shiftedX[NOISE_BATCH];
+    float shiftedY[NOISE_BATCH];
+    float values[NOISE_BATCH];
+    float extra[NOISE_BATCH];
+    
+    for (int y = yBegin; y < yEnd; ++y) {
+        float* row = out + static_cast<size_t>(y) * width;
         
-        for (int i = 0; i < octaves; ++i) {
-            float sampleX = (x / scale) * frequency + octaveOffsets[i * 2];
-            float sampleY = (y / scale) * frequency + octaveOffsets[i * 2 + 1];
+        for (int startX = 0; startX < width; startX += static_cast<int>(NOISE_BATCH)) {
+            size_t count = std::min(NOISE_BATCH, static_cast<size_t>(width - startX));
+            float* total = row + startX;
+            std::fill(total, total + count, 0.0f);
+            
+            float amplitude = 1.0f;
+            float frequency = 1.0f;
+            float maxValue = 0.0f;
             
-            float perlinValue;
-            if (seamless) {
-                float nx = sampleX / width;
-                float ny = sampleY / height;
-                float dx = 1.0f - nx;
-                float dy = 1.0f - ny;
+            for (int octave = 0; octave < settings.octaves; ++octave) {
+                float rowY = (static_cast<float>(originY + y) / settings.scale) * frequency + offsets[octave * 2 + 1];
+                for (size_t i = 0; i < count; i++) {
+                    float x = static_cast<float>(originX + startX + static_cast<int>(i));
+                    sampleX[i] = (x / settings.scale) * frequency + offsets[octave * 2];
+                    sampleY[i] = rowY;
+                }
                 
-                perlinValue = 
-                    this->noise(sampleX, sampleY) * (nx * ny) + 
-                    this->noise(sampleX - width, sampleY) * (dx * ny) + 
-                    this->noise(sampleX, sampleY - height) * (nx * dy) + 
-                    this->noise(sampleX - width, sampleY - height) * (dx * dy);
-            } else {
-                perlinValue = this->noise(sampleX, sampleY);
+                if (seamless) {
+                    // Blend four shifted copies so the map tiles in both directions
+                    noise(sampleX, sampleY, values, count);
+                    for (size_t i = 0; i < count; i++) {
+                        float nx = sampleX[i] / width;
+                        float ny = sampleY[i] / height;
+                        values[i] = values[i] * (nx * ny);
+                        shiftedX[i] = sampleX[i] - width;
+                        shiftedY[i] = sampleY[i] - height;
+                    }
+                    noise(shiftedX, sampleY, extra, count);
+                    for (size_t i = 0; i < count; i++) {
+                        float nx = sampleX[i] / width;
+                        float ny = sampleY[i] / height;
+                        values[i] += extra[i] * ((1.0f - nx) * ny);
+                    }
+                    noise(sampleX, shiftedY, extra, count);
+                    for (size_t i = 0; i < count; i++) {
+                        float nx = sampleX[i] / width;
+                        float ny = sampleY[i] / height;
+                        values[i] += extra[i] * (nx * (1.0f - ny));
+                    }
+                    noise(shiftedX, shiftedY, extra, count);
+                    for (size_t i = 0; i < count; i++) {
+                        float nx = sampleX[i] / width;
+                        float ny = sampleY[i] / height;
+                        values[i] += extra[i] * ((1.0f - nx) * (1.0f - ny));
+                    }
+                } else {
+                    noise(sampleX, sampleY, values, count);
+                }
+                
+                for (size_t i = 0; i < count; i++) {
+                    total[i] += values[i] * amplitude;
+                }
+                maxValue += amplitude;
+                amplitude *= settings.persistence;
+                frequency *= settings.lacunarity;
             }
             
-            noise += perlinValue * amplitude;
-            maxValue += amplitude;
-            amplitude *= persistence;
-            frequency *= lacunarity;
+            // Finish the samples and track the range in the same pass
+            for (size_t i = 0; i < count; i++) {
+                total[i] /= maxValue;
+                range.min = std::min(range.min, total[i]);
+                range.max = std::max(range.max, total[i]);
+            }
         }
-        
-        return noise / maxValue;
-    };
+    }
+}
+
+std::vector<float> PerlinNoise::octaveOffsets(const NoiseMapSettings& settings) const {
+    // Hash the seed with the octave index instead of drawing from a random device,
+    // so the same seed and settings always give the same map
+    std::vector<float> offsets(settings.octaves * 2);
+    for (int i = 0; i < settings.octaves * 2; i += 2) {
+        offsets[i] = offsetFromSeed(seed, i) + settings.offsetX;
+        offsets[i + 1] = offsetFromSeed(seed, i + 1) + settings.offsetY;
+    }
+    return offsets;
+}
+
+void PerlinNoise::fillNoiseMap(float* out, int originX, int originY, int width, int height,
+                               const NoiseMapSettings& settings, bool seamless,
+                               unsigned threadCount, NoiseRange* range) const {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    
+    NoiseMapSettings clamped = settings;
+    if (clamped.scale <= 0) {
+        clamped.scale = 0.0001f;
+    }
+    std::vector<float> offsets = octaveOffsets(clamped);
+    
+    // Small maps aren't worth the thread start-up cost
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (static_cast<size_t>(width) * height < MIN_PARALLEL_SAMPLES) {
+        threadCount = 1;
+    }
+    threadCount = std::min(threadCount, static_cast<unsigned>(height));
+    
+    // Each thread gets one contiguous band of rows and its own min/max
+    const NoiseRange emptyRange = {std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()};
+    std::vector<NoiseRange> bandRanges(threadCount, emptyRange);
+    int rowsPerBand = (height + static_cast<int>(threadCount) - 1) / static_cast<int>(threadCount);
+    
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (unsigned band = 1; band < threadCount; band++) {
+        int yBegin = std::min(height, static_cast<int>(band) * rowsPerBand);
+        int yEnd = std::min(height, yBegin + rowsPerBand);
+        workers.emplace_back([=, &clamped, &offsets, &bandRanges]() {
+            generateNoiseRows(out, originX, originY, width, height, yBegin, yEnd, clamped,
+                              offsets.data(), seamless, bandRanges[band]);
+        });
+    }
+    generateNoiseRows(out, originX, originY, width, height, 0, std::min(height, rowsPerBand), clamped,
+                      offsets.data(), seamless, bandRanges[0]);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    
+    if (range) {
+        *range = emptyRange;
+        for (const NoiseRange& bandRange : bandRanges) {
+            range->min = std::min(range->min, bandRange.min);
+            range->max = std::max(range->max, bandRange.max);
+        }
+    }
+}
+
+void PerlinNoise::generateNoiseMap(float* out, int width, int height, float scale,
+                                   int octaves, float persistence,
+                                   float lacunarity, float offsetX,
+                                   float offsetY, bool seamless,
+                                   unsigned threadCount, NoiseRange* range) const {
+    const NoiseMapSettings settings = {scale, octaves, persistence, lacunarity, offsetX, offsetY};
+    fillNoiseMap(out, 0, 0, width, height, settings, seamless, threadCount, range);
+}
+
+void PerlinNoise::generateNoiseRegion(float* out, int originX, int originY, int width, int height,
+                                      const NoiseMapSettings& settings,
+                                      unsigned threadCount, NoiseRange* range) const {
+    fillNoiseMap(out, originX, originY, width, height, settings, false, threadCount, range);
+}
+
+std::vector<std::vector<float>> PerlinNoise::generateNoiseMap(int width, int height, float scale,
+                                                             int octaves, float persistence, 
+                                                             float lacunarity, float offsetX, 
+                                                             float offsetY, bool seamless) const {
+    std::vector<std::vector<float>> noiseMap(width, std::vector<float>(height, 0.0f));
+    if (width <= 0 || height <= 0) {
+        return noiseMap;
+    }
+    
+    std::vector<float> flat(static_cast<size_t>(width) * height);
+    generateNoiseMap(flat.data(), width, height, scale, octaves, persistence,
+                     lacunarity, offsetX, offsetY, seamless);
     
-    // Multi-threaded version - disabled to avoid compiler warnings
-    // #pragma omp parallel for collapse(2)
     for (int y = 0; y < height; ++y) {
+        const float* row = &flat[static_cast<size_t>(y) * width];
         for (int x = 0; x < width; ++x) {
-            noiseMap[x][y] = sampleNoise(static_cast<float>(x), static_cast<float>(y));
+            noiseMap[x][y] = row[x];
         }
     }
     
     return noiseMap;
 }
 
+void PerlinNoise::normalizeNoiseMap(float* data, size_t count, float minValue, float maxValue,
+                                    const NoiseRange* range) {
+    if (count == 0) {
+        return;
+    }
+    
+    // Find min and max noise values unless the generator already reported them
+    NoiseRange found = {data[0], data[0]};
+    if (range) {
+        found = *range;
+    } else {
+        for (size_t i = 1; i < count; ++i) {
+            found.min = std::min(found.min, data[i]);
+            found.max = std::max(found.max, data[i]);
+        }
+    }
+    
+    if (found.max == found.min) {
+        return;
+    }
+    
+    float span = found.max - found.min;
+    float targetRange = maxValue - minValue;
+    for (size_t i = 0; i < count; ++i) {
+        // Normalize to [0,1], then scale to the desired range
+        float normalized = (data[i] - found.min) / span;
+        data[i] = minValue + normalized * targetRange;
+    }
+}
+
 std::vector<std::vector<float>> PerlinNoise::normalizeNoiseMap(
     const std::vector<std::vector<float>>& noiseMap, 
     float minValue, float maxValue) {
@@ -187,17 +708,11 @@ std::vector<std::vector<float>> PerlinNoise::normalizeNoiseMap(
         return noiseMap;
     }
     
-    // Create normalized copy
+    // Create normalized copy, rescaling each column in place against the whole map's range
     std::vector<std::vector<float>> normalizedMap = noiseMap;
-    float range = maxValue - minValue;
-    
-    for (size_t i = 0; i < normalizedMap.size(); ++i) {
-        for (size_t j = 0; j < normalizedMap[i].size(); ++j) {
-            // Normalize to [0,1]
-            normalizedMap[i][j] = (normalizedMap[i][j] - min) / (max - min);
-            // Scale to desired range
-            normalizedMap[i][j] = minValue + normalizedMap[i][j] * range;
-        }
+    const NoiseRange range = {min, max};
+    for (auto& column : normalizedMap) {
+        normalizeNoiseMap(column.data(), column.size(), minValue, maxValue, &range);
     }
     
     return normalizedMap;
@@ -4,51 +4,126 @@
 #include <random>
 #include <cmath>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Implementations of the batched noise() overload, fastest last
+enum class NoiseKernel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Smallest and largest value of a noise map
+struct NoiseRange {
+    float min;
+    float max;
+};
+
+// Octave configuration shared by noise map generation and the noise tile cache
+struct NoiseMapSettings {
+    float scale;
+    int octaves;
+    float persistence;
+    float lacunarity;
+    float offsetX;
+    float offsetY;
+};
 
 class PerlinNoise {
 private:
     std::vector<int> p;
+    unsigned long long seed;
 
     float fade(float t) const;
     float lerp(float a, float b, float t) const;
     int fastFloor(float x) const;
-    float grad(int hash, float x, float y, float z) const;
+    float grad(int hash, float x, float y) const;
+    
+    // Per-octave (x, y) sample offsets, derived from the seed so maps are repeatable
+    std::vector<float> octaveOffsets(const NoiseMapSettings& settings) const;
+    
+    // Unshaped sum of the caveNoise layers (before tanh)
+    void caveLayers(const float* xs, const float* ys, float z, float* out, size_t n,
+                    float worminess) const;
+    
+    // Fill rows [yBegin, yEnd) of a row-major noise map and report their min/max
+    void generateNoiseRows(float* out, int originX, int originY, int width, int height,
+                           int yBegin, int yEnd, const NoiseMapSettings& settings,
+                           const float* offsets, bool seamless, NoiseRange& range) const;
+    
+    // Split rows across threads and merge the per-band ranges
+    void fillNoiseMap(float* out, int originX, int originY, int width, int height,
+                      const NoiseMapSettings& settings, bool seamless,
+                      unsigned threadCount, NoiseRange* range) const;
 
 public:
     PerlinNoise(unsigned long long seed = 0);
     
     void reseed(unsigned long long newSeed);
     
+    unsigned long long getSeed() const { return seed; }
+    
     float noise(float x, float y) const;
     
+    // Batched noise: out[i] = noise(xs[i], ys[i]) for n samples. Uses the selected SIMD
+    // kernel; every kernel returns results bit-identical to the scalar overload.
+    void noise(const float* xs, const float* ys, float* out, size_t n) const;
+    
     float octaveNoise(float x, float y, int octaves, float persistence) const;
+    void octaveNoise(const float* xs, const float* ys, float* out, size_t n, 
+                     int octaves, float persistence) const;
+    
+    // Kernel used by the batched API. Defaults to the best one the CPU supports.
+    static NoiseKernel getKernel();
+    static bool setKernel(NoiseKernel kernel);  // Returns false if the CPU lacks it
+    static bool isKernelSupported(NoiseKernel kernel);
+    static const char* getKernelName(NoiseKernel kernel);
+    
+    // Fill a caller-provided row-major buffer of width * height values (index y * width + x).
+    // Rows are split across threadCount threads (0 = one per core); the output does not
+    // depend on the thread count. If range is set it receives the map's min and max,
+    // gathered while generating so normalizing needs no extra pass.
+    void generateNoiseMap(float* out, int width, int height, float scale,
+                          int octaves, float persistence,
+                          float lacunarity, float offsetX,
+                          float offsetY, bool seamless,
+                          unsigned threadCount = 0, NoiseRange* range = nullptr) const;
+    
+    // Same as the flat generateNoiseMap without seamless blending, but for the region whose
+    // top-left sample is (originX, originY). A sample's value depends only on its absolute
+    // position, so regions can be assembled from independently generated tiles.
+    void generateNoiseRegion(float* out, int originX, int originY, int width, int height,
+                             const NoiseMapSettings& settings,
+                             unsigned threadCount = 0, NoiseRange* range = nullptr) const;
     
+    // Column-major convenience wrapper (noiseMap[x][y]) around the flat version
     std::vector<std::vector<float>> generateNoiseMap(
         int width, int height, float scale,
         int octaves, float persistence, 
         float lacunarity, float offsetX, 
         float offsetY, bool seamless) const;
     
+    // Rescale count values in place to [minValue, maxValue]. Pass the range reported by
+    // generateNoiseMap to skip the min/max scan.
+    static void normalizeNoiseMap(float* data, size_t count, float minValue, float maxValue,
+                                  const NoiseRange* range = nullptr);
+    
     std::vector<std::vector<float>> normalizeNoiseMap(
         const std::vector<std::vector<float>>& noiseMap, 
         float minValue, float maxValue);
     
     // Specialized function for cave generation that creates more connected tunnels
-    float caveNoise(float x, float y, float z, float worminess = 0.5) {
-        // Use multiple noise layers at different frequencies
-        float n1 = noise(x, y * worminess);
-        float n2 = noise(x * 2.0f, y * 2.0f * worminess) * 0.5f;
-        float n3 = noise(x * 4.0f, y * 4.0f * worminess) * 0.25f;
-        
-        // Use z parameter for additional dimension if needed
-        float zFactor = z * 0.1f;  // Reduce z influence
-        float n4 = noise(x + zFactor, y + zFactor) * 0.125f;
-        
-        // Combine noise layers
-        float combinedNoise = n1 + n2 + n3 + n4;
-        
-        // Apply a transformation to create more tunnel-like structures
-        // This creates sharper transitions between cave and solid
-        return (std::tanh(combinedNoise * 2.0f - 1.0f) + 1.0f) * 0.5f;
-    }
+    float caveNoise(float x, float y, float z, float worminess = 0.5f) const;
+    
+    // Batched caveNoise for n samples sharing one z; bit-identical to the scalar version
+    void caveNoise(const float* xs, const float* ys, float z, float* out, size_t n,
+                   float worminess = 0.5f) const;
+    
+    // carve[i] = caveNoise(xs[i], ys[i], z) > threshold, returning how many were set.
+    // The tanh shaping is monotonic, so this compares the unshaped noise against the
+    // inverted threshold instead, and only evaluates tanh for the few samples close
+    // enough to it that rounding could decide the answer.
+    size_t caveMask(const float* xs, const float* ys, float z, float threshold,
+                    uint8_t* carve, size_t n, float worminess = 0.5f) const;
 }; 
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <random>
 #include <iostream>
@@ -9,6 +10,7 @@
 
 #include "engine/PerlinNoise.h"
 #include "world/World.h"
+#include "render/WorldRenderer.h"
 #include "engine/Camera.h"
 #include "ui/MenuState.h"
 
@@ -55,10 +57,26 @@ int main() {
     // Create the world
     World world(worldHeight, tileSize, seed);
     
+    // Create the renderer that draws it
+    WorldRenderer renderer("assets/textures/");
+    renderer.loadTextures();
+    
+    // Chunk budget for normal zoom; raised while far-zoomed views are drawn from overviews
+    const int defaultChunkBudget = world.getMaxActiveChunks();
+    
     // Create camera
     Camera camera(windowWidth, windowHeight, world.getWorldWidth(), world.getWorldHeight());
     camera.setCreativeMode(gameMode == GameMode::CREATIVE);
     
+    // Reset the camera and centre it on the ground below it
+    auto resetCameraOnSurface = [&world, &camera]() {
+        camera.reset();
+        float centerX = camera.getView().getCenter().x;
+        int surfaceY = world.getSurfaceY(static_cast<int>(centerX) / tileSize);
+        camera.setPosition(centerX, static_cast<float>(surfaceY * tileSize));
+    };
+    resetCameraOnSurface();
+    
     // Set up menu callbacks
     menuState.setOnStateChange([&currentState](GameState newState) {
         currentState = newState;
@@ -179,7 +197,7 @@ int main() {
                         seed = dis(gen);
                         std::cout << "Generated new world with seed: " << seed << std::endl;
                         world.reset(seed);
-                        camera.reset();
+                        resetCameraOnSurface();
                     }
                     
                     // Toggle creative mode (only if not in hardcore)
@@ -189,13 +207,19 @@ int main() {
                         camera.setCreativeMode(gameMode == GameMode::CREATIVE);
                     }
                     
+                    // Toggle drawing chunk sections from baked textures
+                    if (event.key.code == sf::Keyboard::B) {
+                        renderer.setBakingEnabled(!renderer.isBakingEnabled());
+                        std::cout << "Section baking " << (renderer.isBakingEnabled() ? "on" : "off") << std::endl;
+                    }
+                    
                     // Zoom controls
                     if (event.key.code == sf::Keyboard::Add || event.key.code == sf::Keyboard::Equal)
                         camera.zoom(0.9f);
                     if (event.key.code == sf::Keyboard::Subtract || event.key.code == sf::Keyboard::Dash)
                         camera.zoom(1.1f);
                     if (event.key.code == sf::Keyboard::Num0)
-                        camera.reset();
+                        resetCameraOnSurface();
                 }
             }
             
@@ -228,21 +252,39 @@ int main() {
                 }
                 
                 camera.move(dx, dy, dt);
+            } else {
+                camera.stop();
             }
             
             // Get the current camera view
             const sf::View& view = camera.getView();
             float centerX = view.getCenter().x;
             
-            // Update the world (load/unload chunks)
-            world.update(centerX);
+            // Update the world (load/unload chunks, prefetching in the direction of travel)
+            float viewLeft = centerX - view.getSize().x / 2;
+            float viewRight = centerX + view.getSize().x / 2;
+            int chunkBudget = std::max(defaultChunkBudget, renderer.getOverviewChunkBudget(view, window.getSize(), world));
+            if (chunkBudget != world.getMaxActiveChunks()) {
+                world.setMaxActiveChunks(chunkBudget);
+            }
+            world.update(viewLeft, viewRight, camera.getVelocity().x);
             
             // Update chunk information text
             int currentChunk = static_cast<int>(centerX) / (16 * tileSize);
             
             std::string chunkInfo = "Chunk: " + std::to_string(currentChunk) + 
                                   " / 62499 | Position: " + std::to_string(static_cast<int>(centerX)) + 
-                                  " / " + std::to_string(world.getWorldWidth());
+                                  " / " + std::to_string(world.getWorldWidth()) +
+                                  " | Loaded: " + std::to_string(world.getActiveChunkCount()) +
+                                  " | Cache: " + std::to_string(world.getChunkCache().getHits()) + " hit / " +
+                                  std::to_string(world.getChunkCache().getMisses()) + " miss" +
+                                  " | Quads: " + std::to_string(renderer.getQuadsSubmitted()) + " / " +
+                                  std::to_string(renderer.getQuadsTotal()) +
+                                  (renderer.getOverviewsDrawn() > 0 ? " (overview)" : "") +
+                                  (renderer.isBakingEnabled()
+                                       ? " | Baked: " + std::to_string(renderer.getBakeCache().size()) + " (" +
+                                             std::to_string(renderer.getBakeCache().getMemoryUsage() / (1024 * 1024)) + " MB)"
+                                       : "");
             chunkText.setString(chunkInfo);
             
             // Update game info text
@@ -265,7 +307,7 @@ int main() {
             window.clear(sf::Color(135, 206, 235));
             
             // Draw the world
-            world.draw(window);
+            renderer.draw(window, world);
             
             // Draw UI elements with fixed position relative to the view
             sf::View prevView = window.getView();
@@ -301,5 +343,8 @@ int main() {
         window.display();
     }
     
+    // Where chunk generation time went this session
+    world.getGenerationPipeline().printReport(std::cout);
+    
     return 0;
 } 
\ No newline at end of file
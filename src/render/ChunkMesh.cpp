@@ -0,0 +1,284 @@
+#include "ChunkMesh.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// What the builder does with a tile
+const uint8_t QUAD = 1;    // Its own quad from the atlas
+const uint8_t FILL = 2;    // Covered by an underground fill quad
+const uint8_t DETAIL = 4;  // Covered by a graveled stone quad drawn over the fill
+
+// Tiles nothing can be seen through
+bool isOpaque(TileType type) {
+    return type != TileType::AIR && type != TileType::WATER && type != TileType::LEAVES;
+}
+
+bool isOre(TileType type) {
+    return type == TileType::COAL_ORE || type == TileType::IRON_ORE ||
+           type == TileType::GOLD_ORE || type == TileType::DIAMOND_ORE;
+}
+
+// Tiles the stone fill stands in for once they are buried
+bool isRock(TileType type) {
+    return type == TileType::STONE || type == TileType::GRAVELED_STONE ||
+           type == TileType::BEDROCK || isOre(type);
+}
+
+void appendQuad(std::vector<sf::Vertex>& quads, float left, float top, float width, float height,
+                const sf::FloatRect& uv) {
+    quads.emplace_back(sf::Vector2f(left, top), sf::Vector2f(uv.left, uv.top));
+    quads.emplace_back(sf::Vector2f(left + width, top), sf::Vector2f(uv.left + uv.width, uv.top));
+    quads.emplace_back(sf::Vector2f(left + width, top + height), sf::Vector2f(uv.left + uv.width, uv.top + uv.height));
+    quads.emplace_back(sf::Vector2f(left, top + height), sf::Vector2f(uv.left, uv.top + uv.height));
+}
+
+// Swap one section's quads in an array laid out by section for new ones, shifting the
+// sections after it. Same-sized replacements (most single-tile edits) are copied in place.
+void replaceSection(std::vector<sf::Vertex>& quads, std::vector<size_t>& starts, int section,
+                    const std::vector<sf::Vertex>& replacement) {
+    const size_t oldCount = starts[section + 1] - starts[section];
+    const size_t newCount = replacement.size() / 4;
+    auto begin = quads.begin() + starts[section] * 4;
+    if (newCount == oldCount) {
+        std::copy(replacement.begin(), replacement.end(), begin);
+        return;
+    }
+
+    begin = quads.erase(begin, begin + oldCount * 4);
+    quads.insert(begin, replacement.begin(), replacement.end());
+    for (size_t s = section + 1; s < starts.size(); s++) {
+        starts[s] = starts[s] - oldCount + newCount;
+    }
+}
+
+// Draw quads [first section, last section] of an array laid out by section
+size_t drawRange(sf::RenderTarget& target, const std::vector<sf::Vertex>& quads, const std::vector<size_t>& starts,
+                 int first, int last, const sf::Texture* texture) {
+    size_t start = starts[first];
+    size_t count = starts[last + 1] - start;
+    if (count == 0 || !texture) {
+        return 0;
+    }
+
+    sf::RenderStates states;
+    states.texture = texture;
+    target.draw(quads.data() + start * 4, count * 4, sf::Quads, states);
+    return count;
+}
+
+} // namespace
+
+ChunkMesh::ChunkMesh() :
+    revision(0),
+    tileSize(0),
+    sectionPixels(0.0f) {
+}
+
+void ChunkMesh::build(const Chunk& chunk, const TileManager& tileManager, int tileSize) {
+    // Cleared arrays keep their capacity, so rebuilding a chunk doesn't reallocate
+    vertices.clear();
+    detail.clear();
+    fill.clear();
+    revision = chunk.getRevision();
+    this->tileSize = tileSize;
+
+    const int sectionCount = chunk.getSectionCount();
+    sectionPixels = static_cast<float>(tileSize * Chunk::SECTION_HEIGHT);
+    sectionStarts.assign(sectionCount + 1, 0);
+    detailStarts.assign(sectionCount + 1, 0);
+    fillStarts.assign(sectionCount + 1, 0);
+    sectionRevisions.assign(sectionCount, 0);
+
+    std::vector<uint8_t> kinds;
+    for (int s = 0; s < sectionCount; s++) {
+        sectionStarts[s] = vertices.size() / 4;
+        detailStarts[s] = detail.size() / 4;
+        fillStarts[s] = fill.size() / 4;
+        sectionRevisions[s] = chunk.getSectionRevision(s);
+        buildSection(chunk, tileManager, s, kinds, vertices, detail, fill);
+    }
+    sectionStarts[sectionCount] = vertices.size() / 4;
+    detailStarts[sectionCount] = detail.size() / 4;
+    fillStarts[sectionCount] = fill.size() / 4;
+}
+
+int ChunkMesh::update(const Chunk& chunk, const TileManager& tileManager, int tileSize) {
+    const int sectionCount = chunk.getSectionCount();
+    if (revision == 0 || tileSize != this->tileSize || sectionCount != getSectionCount()) {
+        build(chunk, tileManager, tileSize);
+        return sectionCount;
+    }
+    if (isCurrent(chunk)) {
+        return 0;
+    }
+
+    // Rebuild each stale section on its own and splice it in where the old one was
+    std::vector<uint8_t> kinds;
+    std::vector<sf::Vertex> quads;
+    std::vector<sf::Vertex> detailQuads;
+    std::vector<sf::Vertex> fillQuads;
+    int rebuilt = 0;
+    for (int s = 0; s < sectionCount; s++) {
+        if (sectionRevisions[s] == chunk.getSectionRevision(s)) {
+            continue;
+        }
+
+        quads.clear();
+        detailQuads.clear();
+        fillQuads.clear();
+        buildSection(chunk, tileManager, s, kinds, quads, detailQuads, fillQuads);
+        replaceSection(vertices, sectionStarts, s, quads);
+        replaceSection(detail, detailStarts, s, detailQuads);
+        replaceSection(fill, fillStarts, s, fillQuads);
+        sectionRevisions[s] = chunk.getSectionRevision(s);
+        rebuilt++;
+    }
+    revision = chunk.getRevision();
+    return rebuilt;
+}
+
+void ChunkMesh::buildSection(const Chunk& chunk, const TileManager& tileManager, int section,
+                             std::vector<uint8_t>& kinds, std::vector<sf::Vertex>& quads,
+                             std::vector<sf::Vertex>& detailQuads, std::vector<sf::Vertex>& fillQuads) const {
+    // Air sections have no quads and are skipped without reading tiles
+    if (chunk.getSection(section).isEmpty()) {
+        return;
+    }
+
+    const int chunkWidth = chunk.getWidth();
+    const int worldHeight = chunk.getHeight();
+    const int baseY = section * Chunk::SECTION_HEIGHT;
+    const int rows = std::min(Chunk::SECTION_HEIGHT, worldHeight - baseY);
+
+    // Calculate the world X position of this chunk in pixels
+    const float worldPosX = static_cast<float>(chunk.getWorldX() * tileSize);
+    const float size = static_cast<float>(tileSize);
+
+    // A tile is buried when all four neighbours are opaque; below the world is solid.
+    // Neighbours in the next chunk aren't known here. Plain stone and bedrock look the same
+    // on the fill as on their own quad, so on the edge columns they count the unknown side
+    // as opaque, and everything else counts it as open.
+    // Without a stone texture to fill with, every tile keeps its own quad, and without a
+    // graveled one buried graveled stone does.
+    const bool canFill = tileManager.getTileTexture(TileType::STONE) != nullptr;
+    const bool canFillGraveled = tileManager.getTileTexture(TileType::GRAVELED_STONE) != nullptr;
+    auto isBuried = [&](int x, int y, TileType type) {
+        const bool plain = type == TileType::STONE || type == TileType::BEDROCK;
+        auto opaqueAt = [&](int nx) {
+            return nx < 0 || nx >= chunkWidth ? plain : isOpaque(chunk.tileAt(nx, y));
+        };
+        return canFill && y > 0 && opaqueAt(x - 1) && opaqueAt(x + 1) &&
+               isOpaque(chunk.tileAt(x, y - 1)) && (y == worldHeight - 1 || isOpaque(chunk.tileAt(x, y + 1)));
+    };
+
+    // Classify the section's tiles, emitting the atlas quads as we go
+    const auto& atlasRects = tileManager.getAtlasRects();
+    kinds.assign(static_cast<size_t>(chunkWidth) * Chunk::SECTION_HEIGHT, 0);
+    for (int x = 0; x < chunkWidth; x++) {
+        float left = worldPosX + x * size;
+        for (int y = 0; y < rows; y++) {
+            TileType type = chunk.tileAt(x, baseY + y);
+            if (type == TileType::AIR) {
+                continue;
+            }
+
+            // Buried ore keeps its own quad on top of the fill
+            uint8_t kind = QUAD;
+            if (isRock(type) && isBuried(x, baseY + y, type)) {
+                kind = isOre(type) ? (FILL | QUAD)
+                     : type == TileType::GRAVELED_STONE ? (canFillGraveled ? (FILL | DETAIL) : (FILL | QUAD))
+                     : FILL;
+            }
+            kinds[x * Chunk::SECTION_HEIGHT + y] = kind;
+            if (!(kind & QUAD)) {
+                continue;
+            }
+
+            // Bedrock is drawn with the plain stone texture
+            const sf::FloatRect& uv = atlasRects[static_cast<size_t>(type == TileType::BEDROCK ? TileType::STONE : type)];
+            appendQuad(quads, left, (baseY + y) * size, size, size, uv);
+        }
+    }
+
+    // Greedy-merge the cells marked with one kind: grow each rectangle down its column, then
+    // right while the next column has the same run. Merged cells are cleared as they go.
+    // The tile's own texture repeats once per tile across the rectangle.
+    auto merge = [&](uint8_t mark, TileType texture, std::vector<sf::Vertex>& out) {
+        const sf::FloatRect& tileRect = atlasRects[static_cast<size_t>(texture)];
+        for (int x = 0; x < chunkWidth; x++) {
+            for (int y = 0; y < rows; y++) {
+                if (!(kinds[x * Chunk::SECTION_HEIGHT + y] & mark)) {
+                    continue;
+                }
+
+                int height = 1;
+                while (y + height < rows && (kinds[x * Chunk::SECTION_HEIGHT + y + height] & mark)) {
+                    height++;
+                }
+                int width = 1;
+                for (; x + width < chunkWidth; width++) {
+                    const uint8_t* col = &kinds[(x + width) * Chunk::SECTION_HEIGHT + y];
+                    if (!std::all_of(col, col + height, [mark](uint8_t kind) { return (kind & mark) != 0; })) {
+                        break;
+                    }
+                }
+                for (int fx = x; fx < x + width; fx++) {
+                    for (int fy = y; fy < y + height; fy++) {
+                        kinds[fx * Chunk::SECTION_HEIGHT + fy] &= ~mark;
+                    }
+                }
+
+                sf::FloatRect uv(0.0f, 0.0f, tileRect.width * width, tileRect.height * height);
+                appendQuad(out, worldPosX + x * size, (baseY + y) * size, size * width, size * height, uv);
+            }
+        }
+    };
+
+    // All buried rock first, then the graveled stone among it on top
+    merge(FILL, TileType::STONE, fillQuads);
+    merge(DETAIL, TileType::GRAVELED_STONE, detailQuads);
+}
+
+bool ChunkMesh::matches(const ChunkMesh& other) const {
+    auto sameQuads = [](const std::vector<sf::Vertex>& a, const std::vector<sf::Vertex>& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const sf::Vertex& u, const sf::Vertex& v) {
+            return u.position == v.position && u.texCoords == v.texCoords && u.color == v.color;
+        });
+    };
+    return sectionStarts == other.sectionStarts && detailStarts == other.detailStarts &&
+           fillStarts == other.fillStarts && sameQuads(vertices, other.vertices) &&
+           sameQuads(detail, other.detail) && sameQuads(fill, other.fill);
+}
+
+bool ChunkMesh::getSectionRange(float viewTop, float viewBottom, int& first, int& last) const {
+    if (sectionStarts.empty()) {
+        return false;
+    }
+
+    first = std::max(0, static_cast<int>(std::floor(viewTop / sectionPixels)));
+    last = std::min(getSectionCount() - 1, static_cast<int>(std::floor(viewBottom / sectionPixels)));
+    return first <= last;
+}
+
+size_t ChunkMesh::draw(sf::RenderTarget& target, const TileManager& tileManager, float viewTop,
+                       float viewBottom) const {
+    // Sections touching the view; their quads are contiguous, so each array is one draw call
+    int first = 0;
+    int last = 0;
+    if (!getSectionRange(viewTop, viewBottom, first, last)) {
+        return 0;
+    }
+    return drawSections(target, tileManager, first, last);
+}
+
+size_t ChunkMesh::drawSections(sf::RenderTarget& target, const TileManager& tileManager, int first,
+                               int last) const {
+    // Fill first, then the graveled stone over it, then the tiles drawn individually on top
+    const sf::Texture& atlas = tileManager.getAtlasTexture();
+    size_t submitted = drawRange(target, fill, fillStarts, first, last, tileManager.getTileTexture(TileType::STONE));
+    submitted += drawRange(target, detail, detailStarts, first, last,
+                           tileManager.getTileTexture(TileType::GRAVELED_STONE));
+    submitted += drawRange(target, vertices, sectionStarts, first, last, &atlas);
+    return submitted;
+}
@@ -0,0 +1,106 @@
+#include "ChunkOverview.h"
+#include <algorithm>
+#include <cmath>
+
+ChunkOverview::ChunkOverview() :
+    revision(0) {
+}
+
+void ChunkOverview::build(const Chunk& chunk, const TileManager& tileManager) {
+    revision = chunk.getRevision();
+
+    // Bedrock is drawn with the stone texture, so it takes stone's colour here too
+    for (int i = 0; i < TILE_TYPE_COUNT; i++) {
+        colors[i] = tileManager.getTileColor(static_cast<TileType>(i));
+    }
+    colors[static_cast<size_t>(TileType::AIR)] = sf::Color::Transparent;
+    colors[static_cast<size_t>(TileType::BEDROCK)] = colors[static_cast<size_t>(TileType::STONE)];
+
+    const unsigned int width = static_cast<unsigned int>(chunk.getWidth());
+    const unsigned int height = static_cast<unsigned int>(chunk.getHeight());
+    pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+    sectionRevisions.assign(chunk.getSectionCount(), 0);
+    for (int s = 0; s < chunk.getSectionCount(); s++) {
+        sectionRevisions[s] = chunk.getSectionRevision(s);
+        fillSection(chunk, s);
+    }
+
+    if (texture.getSize() != sf::Vector2u(width, height) && !texture.create(width, height)) {
+        revision = 0;
+        return;
+    }
+    texture.update(pixels.data());
+
+    // Sharp when a tile covers a pixel or two, averaged through the mip chain beyond that
+    texture.setSmooth(false);
+    texture.generateMipmap();
+}
+
+int ChunkOverview::update(const Chunk& chunk, const TileManager& tileManager) {
+    const unsigned int width = static_cast<unsigned int>(chunk.getWidth());
+    if (revision == 0 || static_cast<int>(sectionRevisions.size()) != chunk.getSectionCount()) {
+        build(chunk, tileManager);
+        return chunk.getSectionCount();
+    }
+    if (isCurrent(chunk)) {
+        return 0;
+    }
+
+    // Upload just the rows of each stale section, then regenerate the mips from them
+    int refreshed = 0;
+    for (int s = 0; s < chunk.getSectionCount(); s++) {
+        if (sectionRevisions[s] == chunk.getSectionRevision(s)) {
+            continue;
+        }
+
+        sectionRevisions[s] = chunk.getSectionRevision(s);
+        fillSection(chunk, s);
+        int baseY = s * Chunk::SECTION_HEIGHT;
+        int rows = std::min(Chunk::SECTION_HEIGHT, chunk.getHeight() - baseY);
+        texture.update(&pixels[static_cast<size_t>(baseY) * width * 4], width, static_cast<unsigned int>(rows), 0,
+                       static_cast<unsigned int>(baseY));
+        refreshed++;
+    }
+    texture.generateMipmap();
+    revision = chunk.getRevision();
+    return refreshed;
+}
+
+void ChunkOverview::fillSection(const Chunk& chunk, int section) {
+    const int width = chunk.getWidth();
+    const int baseY = section * Chunk::SECTION_HEIGHT;
+    const int rows = std::min(Chunk::SECTION_HEIGHT, chunk.getHeight() - baseY);
+    sf::Uint8* out = &pixels[static_cast<size_t>(baseY) * width * 4];
+
+    // Air sections are transparent without reading tiles
+    if (chunk.getSection(section).isEmpty()) {
+        std::fill(out, out + static_cast<size_t>(rows) * width * 4, 0);
+        return;
+    }
+
+    for (int y = baseY; y < baseY + rows; y++) {
+        for (int x = 0; x < width; x++, out += 4) {
+            const sf::Color& color = colors[static_cast<size_t>(chunk.tileAt(x, y))];
+            out[0] = color.r;
+            out[1] = color.g;
+            out[2] = color.b;
+            out[3] = color.a;
+        }
+    }
+}
+
+bool ChunkOverview::draw(sf::RenderTarget& target, float left, int tileSize, float viewTop, float viewBottom) const {
+    const int height = static_cast<int>(texture.getSize().y);
+    int firstRow = std::max(0, static_cast<int>(std::floor(viewTop / tileSize)));
+    int lastRow = std::min(height - 1, static_cast<int>(std::floor(viewBottom / tileSize)));
+    if (firstRow > lastRow) {
+        return false;
+    }
+
+    // One texel per tile, scaled up to tile size
+    sf::Sprite sprite(texture, sf::IntRect(0, firstRow, static_cast<int>(texture.getSize().x), lastRow - firstRow + 1));
+    sprite.setPosition(left, static_cast<float>(firstRow * tileSize));
+    sprite.setScale(static_cast<float>(tileSize), static_cast<float>(tileSize));
+    target.draw(sprite);
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "../world/Chunk.h"
+#include "TileManager.h"
+
+// A chunk reduced to one texel per tile, coloured with each tile type's average colour,
+// for views zoomed out so far that tiles are a pixel or less on screen. The texture is
+// mipmapped, so further out each screen pixel averages 2x2, 4x4... blocks of tiles, and
+// a chunk always costs one quad however many tiles it covers. Like ChunkMesh it is
+// derived from the chunk, and after an edit only the rows of the changed sections are
+// refilled and uploaded.
+class ChunkOverview {
+private:
+    sf::Texture texture;
+    std::vector<sf::Uint8> pixels;  // Staging buffer, kept so rebuilds don't reallocate
+    uint64_t revision;              // Chunk revision the texture was built from (0 = never built)
+    std::vector<uint64_t> sectionRevisions;  // Chunk section revision each section's rows came from
+    std::array<sf::Color, TILE_TYPE_COUNT> colors;
+
+    // Write one section's rows into the staging buffer
+    void fillSection(const Chunk& chunk, int section);
+
+public:
+    ChunkOverview();
+
+    void build(const Chunk& chunk, const TileManager& tileManager);
+
+    // Refill and upload only the sections that changed since the last build; returns how
+    // many sections were refreshed
+    int update(const Chunk& chunk, const TileManager& tileManager);
+
+    // Draw the rows overlapping [viewTop, viewBottom] in world pixels as one quad at the
+    // chunk's left edge; false if none are in view
+    bool draw(sf::RenderTarget& target, float left, int tileSize, float viewTop, float viewBottom) const;
+
+    // Whether the texture still matches the chunk's tiles
+    bool isCurrent(const Chunk& chunk) const { return revision == chunk.getRevision(); }
+
+    // Staging buffer plus the texture and its mip chain (about a third on top)
+    size_t getMemoryUsage() const {
+        return sizeof(ChunkOverview) + pixels.capacity() + pixels.size() * 4 / 3;
+    }
+};
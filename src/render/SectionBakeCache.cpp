@@ -0,0 +1,133 @@
+#include "SectionBakeCache.h"
+#include <cmath>
+
+SectionBakeCache::SectionBakeCache(size_t budgetBytes) :
+    budgetBytes(budgetBytes),
+    usedBytes(0),
+    frame(0),
+    hits(0),
+    bakes(0),
+    evictions(0) {
+}
+
+const sf::Texture* SectionBakeCache::find(int chunkX, int section, uint64_t revision, int tileSize, float scale) {
+    auto it = index.find(makeKey(chunkX, section));
+    if (it == index.end()) {
+        return nullptr;
+    }
+
+    Bake& bake = *it->second;
+    if (bake.revision != revision || bake.tileSize != tileSize || bake.scale != scale) {
+        return nullptr;
+    }
+
+    // Move to the front of the LRU list
+    bake.lastUsedFrame = frame;
+    entries.splice(entries.begin(), entries, it->second);
+    hits++;
+    return &bake.texture->getTexture();
+}
+
+const sf::Texture* SectionBakeCache::bake(const ChunkMesh& mesh, const TileManager& tileManager, int chunkX,
+                                          int section, const sf::FloatRect& area, uint64_t revision, int tileSize,
+                                          float scale) {
+    const uint64_t key = makeKey(chunkX, section);
+    unsigned int width = static_cast<unsigned int>(std::ceil(area.width * scale));
+    unsigned int height = static_cast<unsigned int>(std::ceil(area.height * scale));
+    const size_t bytes = static_cast<size_t>(width) * height * 4;
+    if (width == 0 || height == 0) {
+        return nullptr;
+    }
+
+    // Render the section's quads with a view over exactly its area
+    auto render = [&](sf::RenderTexture& texture) {
+        texture.setView(sf::View(area));
+        texture.clear(sf::Color::Transparent);
+        mesh.drawSections(texture, tileManager, section, section);
+        texture.display();
+        texture.setSmooth(scale < 1.0f);
+    };
+
+    // A stale bake of the same size (an edit, or a zoom that kept the scale's texture
+    // size) is redrawn in place; otherwise it makes way for a new texture
+    auto existing = index.find(key);
+    if (existing != index.end()) {
+        Bake& stale = *existing->second;
+        if (stale.texture->getSize() == sf::Vector2u(width, height)) {
+            render(*stale.texture);
+            stale.revision = revision;
+            stale.tileSize = tileSize;
+            stale.scale = scale;
+            stale.lastUsedFrame = frame;
+            entries.splice(entries.begin(), entries, existing->second);
+            bakes++;
+            return &stale.texture->getTexture();
+        }
+        remove(existing);
+    }
+
+    if (!makeRoom(bytes)) {
+        return nullptr;
+    }
+    auto texture = std::make_unique<sf::RenderTexture>();
+    if (!texture->create(width, height)) {
+        return nullptr;
+    }
+    render(*texture);
+
+    Bake entry{key, std::move(texture), revision, tileSize, scale, bytes, frame};
+    usedBytes += entry.bytes;
+    entries.push_front(std::move(entry));
+    index[key] = entries.begin();
+    bakes++;
+    return &entries.front().texture->getTexture();
+}
+
+void SectionBakeCache::removeChunk(int chunkX, int sectionCount) {
+    for (int s = 0; s < sectionCount; s++) {
+        auto it = index.find(makeKey(chunkX, s));
+        if (it != index.end()) {
+            remove(it);
+        }
+    }
+}
+
+void SectionBakeCache::clear() {
+    entries.clear();
+    index.clear();
+    usedBytes = 0;
+}
+
+void SectionBakeCache::remove(std::unordered_map<uint64_t, std::list<Bake>::iterator>::iterator it) {
+    usedBytes -= it->second->bytes;
+    entries.erase(it->second);
+    index.erase(it);
+}
+
+bool SectionBakeCache::makeRoom(size_t bytes) {
+    if (bytes > budgetBytes) {
+        return false;
+    }
+    while (usedBytes + bytes > budgetBytes) {
+        if (entries.empty() || entries.back().lastUsedFrame == frame) {
+            return false;
+        }
+        const Bake& oldest = entries.back();
+        usedBytes -= oldest.bytes;
+        index.erase(oldest.key);
+        entries.pop_back();
+        evictions++;
+    }
+    return true;
+}
+
+void SectionBakeCache::evictToBudget() {
+    // Drop least recently drawn bakes until we fit
+    while (usedBytes > budgetBytes && !entries.empty()) {
+        const Bake& oldest = entries.back();
+        usedBytes -= oldest.bytes;
+        index.erase(oldest.key);
+        entries.pop_back();
+        evictions++;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include "ChunkMesh.h"
+#include "TileManager.h"
+
+// Chunk sections rendered once into off-screen textures, so a section that hasn't
+// changed is drawn as a single textured quad instead of its tile quads. A bake is keyed
+// by chunk and section and only reused while the section's revision, the tile size and the
+// bake scale all match; anything else is a miss and gets baked again. Zoomed out, sections
+// are baked at a fraction of their full size (the scale), which keeps wide views cheap.
+// Bounded LRU: the least recently drawn bakes go first once the memory budget is exceeded,
+// but never one drawn in the current frame - when the view needs more than the budget the
+// rest of it simply isn't baked, rather than bakes evicting each other every frame.
+class SectionBakeCache {
+private:
+    struct Bake {
+        uint64_t key;
+        std::unique_ptr<sf::RenderTexture> texture;
+        uint64_t revision;
+        int tileSize;
+        float scale;
+        size_t bytes;
+        uint64_t lastUsedFrame;
+    };
+
+    // Most recently used bake at the front
+    std::list<Bake> entries;
+    std::unordered_map<uint64_t, std::list<Bake>::iterator> index;
+
+    size_t budgetBytes;
+    size_t usedBytes;
+    uint64_t frame;
+
+    uint64_t hits;
+    uint64_t bakes;
+    uint64_t evictions;
+
+    static uint64_t makeKey(int chunkX, int section) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(section);
+    }
+
+    void remove(std::unordered_map<uint64_t, std::list<Bake>::iterator>::iterator it);
+    // Evict until bytes more would fit; false if that would take a bake used this frame
+    bool makeRoom(size_t bytes);
+    void evictToBudget();
+
+public:
+    static const size_t DEFAULT_BUDGET_BYTES = 64 * 1024 * 1024;
+
+    explicit SectionBakeCache(size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+
+    // Call once per frame before the first find()
+    void beginFrame() { frame++; }
+
+    // The baked texture of a section if it is still valid for these parameters, nullptr otherwise
+    const sf::Texture* find(int chunkX, int section, uint64_t revision, int tileSize, float scale);
+
+    // Render one section of a mesh into a texture; area is the section's rectangle in world
+    // pixels. Returns nullptr if the texture couldn't be created or didn't fit the budget.
+    const sf::Texture* bake(const ChunkMesh& mesh, const TileManager& tileManager, int chunkX, int section,
+                            const sf::FloatRect& area, uint64_t revision, int tileSize, float scale);
+
+    // Drop every bake of a chunk (when the chunk is unloaded)
+    void removeChunk(int chunkX, int sectionCount);
+
+    void clear();
+
+    void setBudget(size_t bytes) { budgetBytes = bytes; evictToBudget(); }
+
+    size_t getBudget() const { return budgetBytes; }
+    size_t getMemoryUsage() const { return usedBytes; }
+    size_t size() const { return entries.size(); }
+    uint64_t getHits() const { return hits; }
+    uint64_t getBakes() const { return bakes; }
+    uint64_t getEvictions() const { return evictions; }
+};
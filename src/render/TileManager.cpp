@@ -0,0 +1,258 @@
+#include "TileManager.h"
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+
+TileManager::TileManager(const std::string& path) : texturePath(path) {
+    tileColors.fill(sf::Color::Transparent);
+    std::cout << "Initializing TileManager with path: " << path << std::endl;
+    initializeTileFilenames();
+}
+
+void TileManager::initializeTileFilenames() {
+    // Map tile types to their respective filenames
+    tileFilenames[TileType::GRASS] = "dirt_grass.png";
+    tileFilenames[TileType::DIRT] = "dirt.png";
+    tileFilenames[TileType::STONE] = "stone.png";
+    tileFilenames[TileType::BEDROCK] = "stone_coal.png"; // Using coal stone as bedrock
+    tileFilenames[TileType::TRUNK] = "oak_wood.png";
+    tileFilenames[TileType::LEAVES] = "leaves_transparent.png";
+    tileFilenames[TileType::SNOW_GRASS] = "dirt_snow.png";
+    tileFilenames[TileType::SNOW] = "snow.png";
+    tileFilenames[TileType::COAL_ORE] = "stone_coal.png";
+    tileFilenames[TileType::IRON_ORE] = "stone_silver.png"; // Using silver for iron
+    tileFilenames[TileType::GOLD_ORE] = "stone_gold.png";
+    tileFilenames[TileType::DIAMOND_ORE] = "stone_diamond.png";
+    tileFilenames[TileType::GRAVELED_STONE] = "gravel_stone.png";
+    tileFilenames[TileType::BRICK] = "brick_grey.png";
+    tileFilenames[TileType::WATER] = "water.png";
+    tileFilenames[TileType::SAND] = "sand.png"; // Now using actual sand.png
+    tileFilenames[TileType::LAVA] = "lava.png";
+}
+
+bool TileManager::loadTextures() {
+    bool success = true;
+    int loadedCount = 0;
+    int failedCount = 0;
+    
+    std::cout << "Loading textures from: " << texturePath << std::endl;
+    
+    // Check if directory exists
+    std::ifstream testFile(texturePath + "dirt.png");
+    if (!testFile.good()) {
+        std::cerr << "ERROR: Texture directory might not exist or is inaccessible!" << std::endl;
+        std::cerr << "Current working directory: ";
+        system("cd");
+        std::cerr << "Checking texture directory content:" << std::endl;
+        system(("dir " + texturePath).c_str());
+    }
+    testFile.close();
+    
+    // Clear any existing textures
+    tileTextures.clear();
+    tileColors.fill(sf::Color::Transparent);
+    
+    // Keep the decoded images around so the atlas can be packed without reading textures back
+    std::vector<std::pair<TileType, sf::Image>> images;
+    
+    // Load all textures in enum order so the atlas layout is stable
+    for (int i = 0; i < TILE_TYPE_COUNT; i++) {
+        TileType type = static_cast<TileType>(i);
+        auto nameIt = tileFilenames.find(type);
+        if (nameIt == tileFilenames.end()) {
+            continue;
+        }
+        
+        const std::string& filename = nameIt->second;
+        std::string fullPath = texturePath + filename;
+        sf::Image image;
+        
+        // Try loading from base directory only (since we flattened the structure)
+        if (!image.loadFromFile(fullPath)) {
+            std::cerr << "Failed to load texture: " << fullPath << std::endl;
+            success = false;
+            failedCount++;
+            
+            // Try one level up as fallback
+            std::string fallbackPath = "../" + texturePath + filename;
+            if (!image.loadFromFile(fallbackPath)) {
+                continue;
+            }
+            std::cout << "Successfully loaded from fallback path: " << fallbackPath << std::endl;
+        }
+        
+        // Disable texture smoothing for pixel art; repeat so fill quads can tile it
+        tileTextures[type].loadFromImage(image);
+        tileTextures[type].setSmooth(false);
+        tileTextures[type].setRepeated(true);
+        
+        // Average colour, weighted by alpha so transparent pixels don't darken it
+        uint64_t red = 0, green = 0, blue = 0, alpha = 0;
+        const sf::Uint8* pixels = image.getPixelsPtr();
+        size_t pixelCount = static_cast<size_t>(image.getSize().x) * image.getSize().y;
+        for (size_t p = 0; p < pixelCount; p++) {
+            const sf::Uint8* px = &pixels[p * 4];
+            red += px[0] * px[3];
+            green += px[1] * px[3];
+            blue += px[2] * px[3];
+            alpha += px[3];
+        }
+        if (alpha > 0) {
+            tileColors[i] = sf::Color(static_cast<sf::Uint8>(red / alpha), static_cast<sf::Uint8>(green / alpha),
+                                      static_cast<sf::Uint8>(blue / alpha), static_cast<sf::Uint8>(alpha / pixelCount));
+        }
+        images.emplace_back(type, std::move(image));
+        loadedCount++;
+    }
+    
+    std::cout << "Texture loading summary: " << loadedCount << " loaded, " 
+              << failedCount << " failed" << std::endl;
+    
+    if (!buildAtlas(images)) {
+        std::cerr << "Failed to build tile atlas!" << std::endl;
+        success = false;
+    }
+    
+    return success;
+}
+
+bool TileManager::buildAtlas(const std::vector<std::pair<TileType, sf::Image>>& images) {
+    atlasRects.fill(sf::FloatRect());
+    
+    if (images.empty()) {
+        return false;
+    }
+    
+    // Every tile gets a cell of the largest tile size plus padding on each side
+    unsigned int tileWidth = 0;
+    unsigned int tileHeight = 0;
+    for (const auto& entry : images) {
+        tileWidth = std::max(tileWidth, entry.second.getSize().x);
+        tileHeight = std::max(tileHeight, entry.second.getSize().y);
+    }
+    const unsigned int cellWidth = tileWidth + 2 * ATLAS_PADDING;
+    const unsigned int cellHeight = tileHeight + 2 * ATLAS_PADDING;
+    
+    // Pack the cells into a roughly square grid
+    unsigned int columns = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(images.size()))));
+    unsigned int rows = (static_cast<unsigned int>(images.size()) + columns - 1) / columns;
+    unsigned int atlasWidth = columns * cellWidth;
+    unsigned int atlasHeight = rows * cellHeight;
+    
+    if (atlasWidth > sf::Texture::getMaximumSize() || atlasHeight > sf::Texture::getMaximumSize()) {
+        std::cerr << "Tile atlas " << atlasWidth << "x" << atlasHeight 
+                  << " exceeds the maximum texture size" << std::endl;
+        return false;
+    }
+    
+    sf::Image atlasImage;
+    atlasImage.create(atlasWidth, atlasHeight, sf::Color::Transparent);
+    
+    for (size_t i = 0; i < images.size(); i++) {
+        const sf::Image& image = images[i].second;
+        sf::Vector2u size = image.getSize();
+        unsigned int originX = static_cast<unsigned int>(i % columns) * cellWidth + ATLAS_PADDING;
+        unsigned int originY = static_cast<unsigned int>(i / columns) * cellHeight + ATLAS_PADDING;
+        unsigned int right = originX + size.x - 1;
+        unsigned int bottom = originY + size.y - 1;
+        
+        atlasImage.copy(image, originX, originY);
+        
+        // Extrude the border pixels into the padding so neighbouring tiles never bleed in
+        // when the quads are sampled at fractional zoom levels
+        for (unsigned int p = 1; p <= ATLAS_PADDING; p++) {
+            for (unsigned int x = 0; x < size.x; x++) {
+                atlasImage.setPixel(originX + x, originY - p, image.getPixel(x, 0));
+                atlasImage.setPixel(originX + x, bottom + p, image.getPixel(x, size.y - 1));
+            }
+            for (unsigned int y = 0; y < size.y; y++) {
+                atlasImage.setPixel(originX - p, originY + y, image.getPixel(0, y));
+                atlasImage.setPixel(right + p, originY + y, image.getPixel(size.x - 1, y));
+            }
+        }
+        for (unsigned int py = 1; py <= ATLAS_PADDING; py++) {
+            for (unsigned int px = 1; px <= ATLAS_PADDING; px++) {
+                atlasImage.setPixel(originX - px, originY - py, image.getPixel(0, 0));
+                atlasImage.setPixel(right + px, originY - py, image.getPixel(size.x - 1, 0));
+                atlasImage.setPixel(originX - px, bottom + py, image.getPixel(0, size.y - 1));
+                atlasImage.setPixel(right + px, bottom + py, image.getPixel(size.x - 1, size.y - 1));
+            }
+        }
+        
+        atlasRects[static_cast<size_t>(images[i].first)] = sf::FloatRect(
+            static_cast<float>(originX), static_cast<float>(originY),
+            static_cast<float>(size.x), static_cast<float>(size.y));
+    }
+    
+    if (!atlasTexture.loadFromImage(atlasImage)) {
+        atlasRects.fill(sf::FloatRect());
+        return false;
+    }
+    atlasTexture.setSmooth(false);
+    
+    std::cout << "Built tile atlas " << atlasWidth << "x" << atlasHeight 
+              << " with " << images.size() << " tiles" << std::endl;
+    return true;
+}
+
+const sf::Texture* TileManager::getTileTexture(TileType type) const {
+    auto it = tileTextures.find(type);
+    return it != tileTextures.end() ? &it->second : nullptr;
+}
+
+sf::Texture* TileManager::getTexture(TileType type) {
+    // First check if the texture exists
+    auto it = tileTextures.find(type);
+    if (it != tileTextures.end()) {
+        return &it->second;
+    }
+    
+    // Texture not found, log the issue
+    std::cerr << "Warning: Attempted to get non-existent texture for type: " 
+              << static_cast<int>(type) << std::endl;
+    
+    // Try to use dirt texture as fallback
+    auto fallback = tileTextures.find(TileType::DIRT);
+    if (fallback != tileTextures.end()) {
+        std::cerr << "Using dirt texture as fallback" << std::endl;
+        return &fallback->second;
+    }
+    
+    // If even dirt texture is missing, load an emergency texture
+    if (tileTextures.empty()) {
+        static sf::Texture emergencyTexture;
+        if (!emergencyTexture.loadFromFile("assets/textures/dirt.png")) {
+            // Create a small default texture with a bright color for visibility
+            sf::Image img;
+            img.create(16, 16, sf::Color::Magenta);
+            emergencyTexture.loadFromImage(img);
+            emergencyTexture.setSmooth(false);
+        }
+        std::cerr << "Using emergency texture as last resort" << std::endl;
+        return &emergencyTexture;
+    }
+    
+    // Last resort: return the first available texture
+    std::cerr << "Using first available texture as last resort" << std::endl;
+    return &tileTextures.begin()->second;
+}
+
+void TileManager::setTexturePath(const std::string& path) {
+    std::cout << "Changing texture path from: " << texturePath << " to: " << path << std::endl;
+    texturePath = path;
+    // Reload textures with new path
+    loadTextures();
+}
+
+bool TileManager::areTexturesLoaded() const {
+    // Check if all expected textures are loaded
+    int count = 0;
+    for (const auto& pair : tileFilenames) {
+        if (tileTextures.find(pair.first) == tileTextures.end()) {
+            return false;
+        }
+        count++;
+    }
+    std::cout << "All " << count << " textures are loaded." << std::endl;
+    return true;
+} 
\ No newline at end of file
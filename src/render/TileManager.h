@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <array>
+#include <vector>
+#include <string>
+#include <iostream>
+#include "../world/TileTypes.h"
+
+class TileManager {
+private:
+    // Store textures by tile type
+    std::unordered_map<TileType, sf::Texture> tileTextures;
+    
+    // Path to texture directory
+    std::string texturePath;
+    
+    // Map of tile types to their file names
+    std::unordered_map<TileType, std::string> tileFilenames;
+    
+    // Pixels of extruded border around each tile in the atlas
+    static const unsigned int ATLAS_PADDING = 2;
+    
+    // All tile textures packed into a single texture, and where each tile lives in it.
+    // Indexed directly by TileType so renderers never hash on the hot path.
+    sf::Texture atlasTexture;
+    std::array<sf::FloatRect, TILE_TYPE_COUNT> atlasRects;
+    
+    // Average colour of each tile texture, for drawing tiles smaller than a pixel
+    std::array<sf::Color, TILE_TYPE_COUNT> tileColors;
+    
+    // Initialize the tile filename map
+    void initializeTileFilenames();
+    
+    // Pack the loaded tile images into the atlas and fill the rect table
+    bool buildAtlas(const std::vector<std::pair<TileType, sf::Image>>& images);
+
+public:
+    // Constructor
+    TileManager(const std::string& path = "assets/textures/");
+    
+    // Load all textures
+    bool loadTextures();
+    
+    // Get texture for a specific tile type
+    sf::Texture* getTexture(TileType type);
+    
+    // Texture of a single tile type, set to repeat so one quad can cover a block of
+    // tiles (nullptr if the type has no texture)
+    const sf::Texture* getTileTexture(TileType type) const;
+    
+    // Atlas texture shared by all chunk meshes
+    const sf::Texture& getAtlasTexture() const { return atlasTexture; }
+    
+    // Pixel rectangle of a tile type inside the atlas (empty if the type has no texture)
+    const sf::FloatRect& getAtlasRect(TileType type) const { return atlasRects[static_cast<size_t>(type)]; }
+    
+    // Dense TileType -> atlas rectangle table
+    const std::array<sf::FloatRect, TILE_TYPE_COUNT>& getAtlasRects() const { return atlasRects; }
+    
+    // Average colour of a tile type's texture (transparent if the type has no texture)
+    const sf::Color& getTileColor(TileType type) const { return tileColors[static_cast<size_t>(type)]; }
+    
+    // Set a new texture path
+    void setTexturePath(const std::string& path);
+    
+    // Check if all textures are loaded
+    bool areTexturesLoaded() const;
+}; 
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "WorldRenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+WorldRenderer::WorldRenderer(const std::string& texturePath) :
+    tileManager(texturePath),
+    frame(0),
+    retiredBytes(0),
+    bakingEnabled(false),
+    chunksDrawn(0),
+    quadsSubmitted(0),
+    quadsTotal(0),
+    sectionsRebuilt(0),
+    sectionsBaked(0),
+    bakedSectionsDrawn(0),
+    overviewsDrawn(0) {
+}
+
+void WorldRenderer::setBakingEnabled(bool enabled) {
+    bakingEnabled = enabled;
+    if (!enabled) {
+        bakeCache.clear();
+    }
+}
+
+float WorldRenderer::bakeScaleFor(float tilePixels, int tileSize) {
+    float ratio = tilePixels / static_cast<float>(tileSize);
+    if (ratio >= 1.0f) {
+        return 1.0f;
+    }
+    return std::max(MIN_BAKE_SCALE, std::exp2(std::ceil(std::log2(ratio))));
+}
+
+int WorldRenderer::getOverviewChunkBudget(const sf::View& view, const sf::Vector2u& targetSize,
+                                          const World& world) const {
+    if (tilePixelsFor(view, targetSize, world.getTileSize()) > OVERVIEW_MAX_TILE_PIXELS) {
+        return 0;
+    }
+
+    // The chunks the view spans, plus the margins and prefetch the world loads around it
+    const float chunkPixels = static_cast<float>(world.getChunkWidth() * world.getTileSize());
+    int spanned = static_cast<int>(std::ceil(view.getSize().x / chunkPixels)) + 1;
+    int needed = spanned + 2 * world.getLoadMarginChunks() + world.getMaxPrefetchChunks();
+    return std::min(needed, MAX_OVERVIEW_CHUNKS);
+}
+
+bool WorldRenderer::loadTextures() {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    if (!tileManager.loadTextures()) {
+        std::cerr << "Failed to load one or more textures!" << std::endl;
+        return false;
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    std::cout << "Textures loaded successfully in " << duration.count() << "ms" << std::endl;
+    return true;
+}
+
+void WorldRenderer::draw(sf::RenderTarget& target, const World& world) {
+    frame++;
+    chunksDrawn = 0;
+    quadsSubmitted = 0;
+    quadsTotal = 0;
+    sectionsRebuilt = 0;
+    sectionsBaked = 0;
+    bakedSectionsDrawn = 0;
+    overviewsDrawn = 0;
+    bakeCache.beginFrame();
+
+    // Chunks are culled against the view horizontally, then their sections vertically
+    const sf::View& view = target.getView();
+    float viewLeft = view.getCenter().x - view.getSize().x / 2;
+    float viewRight = view.getCenter().x + view.getSize().x / 2;
+    float viewTop = view.getCenter().y - view.getSize().y / 2;
+    float viewBottom = view.getCenter().y + view.getSize().y / 2;
+    const int tileSize = world.getTileSize();
+    const int chunkPixels = world.getChunkWidth() * tileSize;
+
+    float tilePixels = tilePixelsFor(view, target.getSize(), tileSize);
+    bool useOverview = tilePixels <= OVERVIEW_MAX_TILE_PIXELS;
+
+    // Bakes hold colour already multiplied by alpha, so they are blended without doing it again
+    const float bakeScale = bakeScaleFor(tilePixels, tileSize);
+    const float sectionPixels = static_cast<float>(Chunk::SECTION_HEIGHT * tileSize);
+    const float worldPixels = static_cast<float>(world.getWorldHeight());
+    sf::RenderStates bakedStates;
+    bakedStates.blendMode = sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+
+    world.forEachActiveChunk([&](const Chunk& chunk) {
+        if (!chunk.isActive()) {
+            return;
+        }
+
+        // Loaded chunks keep their mesh while out of view, so panning back is free
+        MeshEntry& entry = meshes[chunk.getChunkX()];
+        entry.lastSeenFrame = frame;
+        if (entry.retired) {
+            retiredMeshes.erase(entry.retiredPosition);
+            retiredBytes -= entry.getMemoryUsage();
+            entry.retired = false;
+        }
+
+        float left = static_cast<float>(chunk.getChunkX()) * chunkPixels;
+        if (left + chunkPixels < viewLeft || left > viewRight) {
+            return;
+        }
+
+        // Far out, the whole chunk is one quad of its overview; it counts as one quad submitted
+        if (useOverview) {
+            sectionsRebuilt += entry.overview.update(chunk, tileManager);
+            if (entry.overview.draw(target, left, tileSize, viewTop, viewBottom)) {
+                chunksDrawn++;
+                overviewsDrawn++;
+                quadsSubmitted++;
+            }
+            quadsTotal++;
+            return;
+        }
+
+        sectionsRebuilt += entry.mesh.update(chunk, tileManager, tileSize);
+        int first = 0;
+        int last = 0;
+        if (!entry.mesh.getSectionRange(viewTop, viewBottom, first, last)) {
+            quadsTotal += entry.mesh.getQuadCount();
+            return;
+        }
+
+        size_t submitted = 0;
+        if (!bakingEnabled) {
+            submitted = entry.mesh.drawSections(target, tileManager, first, last);
+        } else {
+            for (int s = first; s <= last; s++) {
+                if (entry.mesh.getSectionQuadCount(s) == 0) {
+                    continue;
+                }
+
+                // Bakes follow the section's revision, so an edit only invalidates the sections it touched
+                const uint64_t sectionRevision = chunk.getSectionRevision(s);
+                const sf::Texture* baked = bakeCache.find(chunk.getChunkX(), s, sectionRevision, tileSize, bakeScale);
+                if (!baked && sectionsBaked < MAX_BAKES_PER_FRAME) {
+                    float top = s * sectionPixels;
+                    sf::FloatRect area(left, top, static_cast<float>(chunkPixels), std::min(sectionPixels, worldPixels - top));
+                    baked = bakeCache.bake(entry.mesh, tileManager, chunk.getChunkX(), s, area,
+                                           sectionRevision, tileSize, bakeScale);
+                    sectionsBaked++;
+                }
+
+                if (baked) {
+                    sf::Sprite sprite(*baked);
+                    sprite.setPosition(left, s * sectionPixels);
+                    sprite.setScale(1.0f / bakeScale, 1.0f / bakeScale);
+                    target.draw(sprite, bakedStates);
+                    bakedSectionsDrawn++;
+                    submitted++;
+                } else {
+                    submitted += entry.mesh.drawSections(target, tileManager, s, s);
+                }
+            }
+        }
+        chunksDrawn += submitted > 0 ? 1 : 0;
+        quadsSubmitted += submitted;
+        quadsTotal += entry.mesh.getQuadCount();
+    });
+
+    // Retire the meshes of chunks the world no longer has loaded, and forget the oldest
+    // retired ones beyond the budget
+    for (auto& item : meshes) {
+        MeshEntry& entry = item.second;
+        if (entry.lastSeenFrame != frame && !entry.retired) {
+            bakeCache.removeChunk(item.first, entry.mesh.getSectionCount());
+            entry.retired = true;
+            entry.retiredPosition = retiredMeshes.insert(retiredMeshes.begin(), item.first);
+            retiredBytes += entry.getMemoryUsage();
+        }
+    }
+    while (retiredBytes > RETIRED_MESH_BUDGET_BYTES) {
+        auto oldest = meshes.find(retiredMeshes.back());
+        retiredBytes -= oldest->second.getMemoryUsage();
+        retiredMeshes.pop_back();
+        meshes.erase(oldest);
+    }
+}
+
+size_t WorldRenderer::getMeshMemory() const {
+    size_t bytes = 0;
+    for (const auto& entry : meshes) {
+        bytes += entry.second.getMemoryUsage();
+    }
+    return bytes;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "../world/World.h"
+#include "ChunkMesh.h"
+#include "ChunkOverview.h"
+#include "SectionBakeCache.h"
+#include "TileManager.h"
+
+// Draws a World. Owns the tile textures and a mesh per loaded chunk, built on the main
+// thread the first time the chunk is in view; after edits only the changed sections of
+// the mesh are rebuilt, and only their bakes are redone.
+// Meshes of chunks the world has unloaded are kept in a small LRU, so a chunk that comes
+// back from the world's cache is drawn without a rebuild; a chunk generated again has new
+// section revisions, so its old mesh is simply rebuilt.
+// With baking on, visible sections are drawn from textures in a SectionBakeCache instead,
+// falling back to the mesh for sections not baked yet. Zoomed out until tiles are a couple
+// of pixels or less, chunks are drawn from a ChunkOverview instead - one quad per chunk,
+// so far-zoom frames cost the same however many tiles are in view.
+class WorldRenderer {
+private:
+    // Sections baked per frame at most, so turning baking on or zooming doesn't stall a frame
+    static const int MAX_BAKES_PER_FRAME = 16;
+    // Smallest bake scale; sections are never baked at less than 1/16 of their size
+    static constexpr float MIN_BAKE_SCALE = 1.0f / 16.0f;
+    // At or below this many screen pixels per tile, chunks are drawn from their overview
+    static constexpr float OVERVIEW_MAX_TILE_PIXELS = 2.0f;
+    // Most chunks to ask the world to load for an overview; a loaded chunk and its overview
+    // take about 15 KB, so this is some 6 MB. Past it the view's edges stay empty.
+    static constexpr int MAX_OVERVIEW_CHUNKS = 384;
+    // Memory kept for the meshes of unloaded chunks; a close-up mesh is about 80 KB
+    static const size_t RETIRED_MESH_BUDGET_BYTES = 16 * 1024 * 1024;
+
+    struct MeshEntry {
+        ChunkMesh mesh;
+        ChunkOverview overview;  // Only built once the chunk is seen zoomed out
+        uint64_t lastSeenFrame = 0;
+        bool retired = false;    // Its chunk is no longer loaded
+        std::list<int>::iterator retiredPosition;
+
+        size_t getMemoryUsage() const { return mesh.getMemoryUsage() + overview.getMemoryUsage(); }
+    };
+
+    TileManager tileManager;
+
+    // Chunk X -> mesh, for loaded chunks and retired ones
+    std::unordered_map<int, MeshEntry> meshes;
+    uint64_t frame;
+
+    // Chunk X of the retired meshes, most recently unloaded first
+    std::list<int> retiredMeshes;
+    size_t retiredBytes;
+
+    SectionBakeCache bakeCache;
+    bool bakingEnabled;
+
+    // Stats for the last draw() call
+    size_t chunksDrawn;
+    size_t quadsSubmitted;  // Quads in the sections overlapping the view
+    size_t quadsTotal;      // Quads in every chunk overlapping the view horizontally
+    size_t sectionsRebuilt;  // Mesh and overview sections rebuilt for changed tiles
+    size_t sectionsBaked;
+    size_t bakedSectionsDrawn;
+    size_t overviewsDrawn;
+
+    // Texture resolution to bake at for tiles this many pixels on screen: a power of two,
+    // so zooming rebakes only when it crosses one
+    static float bakeScaleFor(float tilePixels, int tileSize);
+
+    // Screen pixels a tile covers in a view drawn to a target of this size
+    static float tilePixelsFor(const sf::View& view, const sf::Vector2u& targetSize, int tileSize) {
+        return tileSize * static_cast<float>(targetSize.y) / view.getSize().y;
+    }
+
+public:
+    explicit WorldRenderer(const std::string& texturePath = "assets/textures/");
+
+    // Load the tile textures and build the atlas; false if any texture is missing
+    bool loadTextures();
+
+    // Draw the chunk sections of the world that overlap the target's current view
+    void draw(sf::RenderTarget& target, const World& world);
+
+    // Chunks the world must keep loaded to fill the view while it is drawn from overviews
+    // (at most MAX_OVERVIEW_CHUNKS), or 0 while tiles are big enough to be drawn from meshes.
+    // The world's own budget is sized for close views, so pass this to setMaxActiveChunks.
+    int getOverviewChunkBudget(const sf::View& view, const sf::Vector2u& targetSize, const World& world) const;
+
+    // Draw unchanged sections from baked textures (off by default)
+    void setBakingEnabled(bool enabled);
+    bool isBakingEnabled() const { return bakingEnabled; }
+    SectionBakeCache& getBakeCache() { return bakeCache; }
+    const SectionBakeCache& getBakeCache() const { return bakeCache; }
+
+    const TileManager& getTileManager() const { return tileManager; }
+    size_t getMeshCount() const { return meshes.size() - retiredMeshes.size(); }
+    size_t getRetiredMeshCount() const { return retiredMeshes.size(); }
+    size_t getMeshMemory() const;
+    size_t getChunksDrawn() const { return chunksDrawn; }
+    size_t getQuadsSubmitted() const { return quadsSubmitted; }
+    size_t getQuadsTotal() const { return quadsTotal; }
+    size_t getSectionsRebuilt() const { return sectionsRebuilt; }
+    size_t getSectionsBaked() const { return sectionsBaked; }
+    size_t getBakedSectionsDrawn() const { return bakedSectionsDrawn; }
+    size_t getOverviewsDrawn() const { return overviewsDrawn; }
+};
@@ -1,6 +1,6 @@
 #include "MenuState.h"
 #include <iostream>
-#include "../world/TileManager.h"
+#include "../render/TileManager.h"
 
 MenuState::MenuState() : 
     worldName("New World"),
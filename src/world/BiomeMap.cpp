@@ -0,0 +1,117 @@
+#include "BiomeMap.h"
+#include <algorithm>
+
+namespace {
+
+// Climate: a few hundred columns per biome
+const float CLIMATE_SCALE = 0.09f;      // Per cell
+const int CLIMATE_OCTAVES = 3;
+const float CLIMATE_ROW = 1000.5f;      // Noise row, away from the terrain (row 0) and ore fields
+const float SNOW_BELOW = -0.25f;
+const float DESERT_ABOVE = 0.25f;
+
+// Ore: patches a few cells across, with barren patches in between
+const float ORE_SCALE = 0.35f;          // Per cell
+const int ORE_OCTAVES = 2;
+const float ORE_OFFSET = 2000.5f;
+const float ORE_BARREN_BELOW = -0.1f;   // Noise below this gives richness 0
+const float ORE_FULL_ABOVE = 0.35f;     // Noise above this gives richness 1
+
+// Block or cell containing a coordinate, rounding towards negative infinity
+int floorDiv(int value, int size) {
+    return value >= 0 ? value / size : -((-value - 1) / size) - 1;
+}
+
+} // namespace
+
+BiomeMap::BiomeMap(std::shared_ptr<const PerlinNoise> noise, int worldHeight) :
+    noise(std::move(noise)),
+    worldHeight(worldHeight),
+    cellRows((worldHeight + CELL_SIZE - 1) / CELL_SIZE),
+    // Same shape constants as SurfaceIndex: lows of the terrain end up under water
+    seaLevel(static_cast<int>(worldHeight * 0.5 - worldHeight * 0.18 * 0.4)) {
+}
+
+void BiomeMap::fillBlock(int blockX, Block& block) const {
+    const int firstCell = blockX * BLOCK_CELLS;
+    
+    // Climate at every cell centre of the block plus one cell either side,
+    // so columns near the block edges can interpolate
+    const int climateCells = BLOCK_CELLS + 2;
+    float xs[climateCells];
+    float ys[climateCells];
+    float climate[climateCells];
+    for (int i = 0; i < climateCells; i++) {
+        xs[i] = (firstCell - 1 + i) * CLIMATE_SCALE;
+        ys[i] = CLIMATE_ROW;
+    }
+    noise->octaveNoise(xs, ys, climate, climateCells, CLIMATE_OCTAVES, 0.5f);
+    
+    for (int column = 0; column < BLOCK_COLUMNS; column++) {
+        // Position between the two nearest cell centres (climate[1] is this block's first cell)
+        float position = (column + 0.5f) / CELL_SIZE + 0.5f;
+        int left = static_cast<int>(position);
+        float t = position - left;
+        float value = climate[left] + (climate[left + 1] - climate[left]) * t;
+        
+        block.biomes[column] = value < SNOW_BELOW ? Biome::SNOW :
+                               value > DESERT_ABOVE ? Biome::DESERT : Biome::PLAINS;
+    }
+    
+    // Ore richness at every cell centre, all rows in one batch
+    size_t cells = static_cast<size_t>(BLOCK_CELLS) * cellRows;
+    std::vector<float> oreX(cells);
+    std::vector<float> oreY(cells);
+    block.oreRichness.resize(cells);
+    for (int row = 0; row < cellRows; row++) {
+        for (int cell = 0; cell < BLOCK_CELLS; cell++) {
+            oreX[row * BLOCK_CELLS + cell] = (firstCell + cell + 0.5f) * ORE_SCALE + ORE_OFFSET;
+            oreY[row * BLOCK_CELLS + cell] = (row + 0.5f) * ORE_SCALE + ORE_OFFSET;
+        }
+    }
+    noise->octaveNoise(oreX.data(), oreY.data(), block.oreRichness.data(), cells, ORE_OCTAVES, 0.5f);
+    
+    for (float& richness : block.oreRichness) {
+        richness = std::min(1.0f, std::max(0.0f, (richness - ORE_BARREN_BELOW) / (ORE_FULL_ABOVE - ORE_BARREN_BELOW)));
+    }
+}
+
+BiomeMap::Block& BiomeMap::getBlock(int blockX) {
+    auto it = blocks.find(blockX);
+    if (it != blocks.end()) {
+        return it->second;
+    }
+    
+    Block& block = blocks[blockX];
+    fillBlock(blockX, block);
+    return block;
+}
+
+void BiomeMap::getBiomes(int firstWorldX, int count, Biome* out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < count; i++) {
+        int worldX = firstWorldX + i;
+        int blockX = floorDiv(worldX, BLOCK_COLUMNS);
+        out[i] = getBlock(blockX).biomes[worldX - blockX * BLOCK_COLUMNS];
+    }
+}
+
+void BiomeMap::getOreRichness(int firstWorldX, int count, float* out) {
+    const int firstCell = floorDiv(firstWorldX, CELL_SIZE);
+    const int cellsWide = (count + CELL_SIZE - 1) / CELL_SIZE;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int cell = 0; cell < cellsWide; cell++) {
+        int blockX = floorDiv(firstCell + cell, BLOCK_CELLS);
+        const Block& block = getBlock(blockX);
+        int blockCell = firstCell + cell - blockX * BLOCK_CELLS;
+        for (int row = 0; row < cellRows; row++) {
+            out[row * cellsWide + cell] = block.oreRichness[row * BLOCK_CELLS + blockCell];
+        }
+    }
+}
+
+size_t BiomeMap::getBlockCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return blocks.size();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "../engine/PerlinNoise.h"
+
+enum class Biome : uint8_t {
+    PLAINS,   // Grass over dirt, trees
+    DESERT,   // Sand all the way down to the stone
+    SNOW      // Snowy grass over dirt
+};
+
+// Low-frequency climate and ore fields for one seed. Both are sampled on a coarse grid
+// of CELL_SIZE x CELL_SIZE tiles, a BLOCK_COLUMNS-wide block at a time in one batched
+// noise call, the first time anything asks about the block, and kept for as long as the
+// seed is loaded - so per-tile generation only ever reads cached values. Safe to share
+// between threads.
+class BiomeMap {
+public:
+    static const int CELL_SIZE = 16;
+    static const int BLOCK_COLUMNS = 256;
+    static const int BLOCK_CELLS = BLOCK_COLUMNS / CELL_SIZE;
+
+private:
+    struct Block {
+        std::array<Biome, BLOCK_COLUMNS> biomes;
+        std::vector<float> oreRichness;  // BLOCK_CELLS per cell row, cellRows rows
+    };
+
+    std::shared_ptr<const PerlinNoise> noise;
+    int worldHeight;
+    int cellRows;    // Cell rows covering the world height
+    int seaLevel;    // Rows below this that are open to the sky fill with water
+
+    std::unordered_map<int, Block> blocks;
+    mutable std::mutex mutex;
+
+    // Expects the mutex to be held
+    Block& getBlock(int blockX);
+    void fillBlock(int blockX, Block& block) const;
+
+public:
+    BiomeMap(std::shared_ptr<const PerlinNoise> noise, int worldHeight);
+
+    // Biome of each column in a run
+    void getBiomes(int firstWorldX, int count, Biome* out);
+
+    // Ore richness in [0, 1] for a run of columns starting on a cell boundary, one value
+    // per cell: out[cellY * cellsWide + cellX] with cellsWide = ceil(count / CELL_SIZE)
+    // and getCellRows() rows. 0 means the cell gets no ore at all.
+    void getOreRichness(int firstWorldX, int count, float* out);
+
+    int getCellRows() const { return cellRows; }
+    int getSeaLevel() const { return seaLevel; }
+    size_t getBlockCount() const;
+};
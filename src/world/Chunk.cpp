@@ -1,228 +1,382 @@
 #include "Chunk.h"
-#include <random>
+#include "../engine/HashRandom.h"
+#include <algorithm>
+#include <atomic>
 
-Chunk::Chunk(int x, int width, int height, int tileSize, 
-             sf::Texture* grass, sf::Texture* dirt, sf::Texture* stone, 
-             sf::Texture* graveledStone, sf::Texture* trunk, sf::Texture* leaves) :
+namespace {
+// Shared by every chunk on every thread, so a revision is never reused
+std::atomic<uint64_t> revisionCounter{0};
+}
+
+uint64_t Chunk::nextRevision() {
+    return revisionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+Chunk::Chunk(int x, int width, int height) :
     chunkX(x),
     chunkWidth(width),
     worldHeight(height),
-    tileSize(tileSize),
     isGenerated(false),
-    grassTexture(grass),
-    dirtTexture(dirt),
-    stoneTexture(stone),
-    graveledStoneTexture(graveledStone),
-    trunkTexture(trunk),
-    leavesTexture(leaves) {
-    
-    // Initialize the chunk with air
-    tiles.resize(chunkWidth, std::vector<TileType>(worldHeight, TileType::AIR));
+    revision(nextRevision()) {
+    
+    // Initialize the chunk with air - every section starts uniform and holds no tiles
+    sections.resize((worldHeight + SECTION_HEIGHT - 1) >> SECTION_SHIFT);
+    sectionRevisions.assign(sections.size(), revision);
+}
+
+void Chunk::makeDense(ChunkSection& section) {
+    section.data.assign(static_cast<size_t>(chunkWidth) * SECTION_HEIGHT, section.uniform);
 }
 
-void Chunk::generate(PerlinNoise& terrainNoise, uint64_t seed, int worldOffset) {
-    // Generate terrain and trees for this chunk
-    generateTerrain(terrainNoise, seed, worldOffset);
-    generateTrees(seed, worldOffset);
-    buildSpriteArray();
+void Chunk::collapseUniformSections() {
+    for (size_t s = 0; s < sections.size(); s++) {
+        ChunkSection& section = sections[s];
+        if (section.isUniform()) {
+            continue;
+        }
+        
+        // Only the rows inside the world count; the last section may be partial
+        int rows = std::min(SECTION_HEIGHT, worldHeight - static_cast<int>(s) * SECTION_HEIGHT);
+        TileType first = section.data[0];
+        bool uniform = true;
+        for (int x = 0; x < chunkWidth && uniform; x++) {
+            const TileType* col = &section.data[x * SECTION_HEIGHT];
+            for (int y = 0; y < rows; y++) {
+                if (col[y] != first) {
+                    uniform = false;
+                    break;
+                }
+            }
+        }
+        
+        if (uniform) {
+            section.uniform = first;
+            std::vector<TileType>().swap(section.data);
+        }
+    }
+}
+
+size_t Chunk::getMemoryUsage() const {
+    size_t bytes = sizeof(Chunk) + sections.capacity() * sizeof(ChunkSection) + compressedTiles.capacity() +
+                   sectionRevisions.capacity() * sizeof(uint64_t);
+    for (const ChunkSection& section : sections) {
+        bytes += section.data.capacity() * sizeof(TileType);
+    }
+    return bytes;
+}
+
+void Chunk::finishGeneration() {
+    collapseUniformSections();
     isGenerated = true;
+    markChanged();
+}
+
+void Chunk::compact() {
+    if (isCompact()) {
+        return;
+    }
+    
+    // Encode the tiles column by column as (type, run length) pairs. The air above
+    // the surface collapses to a pair or two per column.
+    compressedTiles.clear();
+    TileType runType = tileAt(0, 0);
+    int run = 0;
+    for (int x = 0; x < chunkWidth; x++) {
+        for (int y = 0; y < worldHeight; y++) {
+            TileType type = tileAt(x, y);
+            if (type != runType || run == 255) {
+                compressedTiles.push_back(static_cast<uint8_t>(runType));
+                compressedTiles.push_back(static_cast<uint8_t>(run));
+                runType = type;
+                run = 0;
+            }
+            run++;
+        }
+    }
+    compressedTiles.push_back(static_cast<uint8_t>(runType));
+    compressedTiles.push_back(static_cast<uint8_t>(run));
+    compressedTiles.shrink_to_fit();
+    
+    std::vector<ChunkSection>().swap(sections);
+}
+
+void Chunk::expand() {
+    if (!isCompact()) {
+        return;
+    }
+    
+    // Only runs of solid tiles are written, so sections that stay air never allocate
+    sections.assign((worldHeight + SECTION_HEIGHT - 1) >> SECTION_SHIFT, ChunkSection());
+    size_t index = 0;
+    for (size_t i = 0; i + 1 < compressedTiles.size(); i += 2) {
+        TileType type = static_cast<TileType>(compressedTiles[i]);
+        size_t run = compressedTiles[i + 1];
+        if (type != TileType::AIR) {
+            for (size_t j = index; j < index + run; j++) {
+                setTileUnchecked(static_cast<int>(j / worldHeight), static_cast<int>(j % worldHeight), type);
+            }
+        }
+        index += run;
+    }
+    std::vector<uint8_t>().swap(compressedTiles);
+    collapseUniformSections();
 }
 
-void Chunk::generateTerrain(PerlinNoise& terrainNoise, uint64_t seed, int worldOffset) {
+void Chunk::generateTerrain(const int* heights, const Biome* biomes, int seaLevel,
+                            uint64_t seed, int worldOffset) {
     // Parameters for terrain generation
-    const double scale = 0.05;
     const int dirtLayers = 3;
-    const int baseHeight = worldHeight * 0.5;
-    const int hillHeight = worldHeight * 0.18;
     
-    // Setup random number generator for graveled stone distribution
-    std::mt19937 rng(seed + chunkX);
-    std::uniform_int_distribution<int> stoneDist(0, 1); // 50% chance for graveled stone
+    // Graveled stone is a 50% coin flip hashed from each tile's world position
+    const uint64_t stoneStream = HashRandom::streamKey(seed, RandomPurpose::STONE_VARIANT);
+    
+    // Highest surface point in the chunk, counting the top of any water
+    int highestSurface = worldHeight;
+    for (int x = 0; x < chunkWidth; x++) {
+        if (heights[x] >= 0) {
+            highestSurface = std::min(highestSurface, std::min(heights[x], seaLevel));
+        }
+    }
+    
+    // Sections above the highest surface stay uniform air and are never touched.
+    // Everything from the surface down is mixed, so allocate it up front.
+    for (size_t s = std::max(0, highestSurface) >> SECTION_SHIFT; s < sections.size(); s++) {
+        if (sections[s].isUniform()) {
+            makeDense(sections[s]);
+        }
+    }
+    
+    // The sections below the surface are dense now, so write straight into their buffers
+    auto tile = [this](int x, int y) -> TileType& {
+        return sections[y >> SECTION_SHIFT].data[x * SECTION_HEIGHT + (y & (SECTION_HEIGHT - 1))];
+    };
     
-    // Generate the base terrain heightmap for this chunk
     for (int x = 0; x < chunkWidth; x++) {
-        // Calculate the world x-coordinate
         int worldX = worldOffset + x;
-        
-        // Use perlin noise to generate the height at this position
-        double heightValue = terrainNoise.noise(worldX * scale, 0) * 0.5 + 0.5;
-        int terrainHeight = baseHeight - hillHeight * heightValue;
+        int terrainHeight = heights[x];
         
         if (terrainHeight >= 0 && terrainHeight < worldHeight) {
-            tiles[x][terrainHeight] = TileType::GRASS;
+            // Top tile and the layers under it depend on the biome
+            TileType top = TileType::GRASS;
+            TileType filler = TileType::DIRT;
+            if (biomes[x] == Biome::DESERT) {
+                top = TileType::SAND;
+                filler = TileType::SAND;
+            } else if (biomes[x] == Biome::SNOW) {
+                top = TileType::SNOW_GRASS;
+                filler = TileType::SNOW;
+            }
+            
+            // Ground below sea level is a sandy bed under water
+            if (terrainHeight > seaLevel) {
+                top = TileType::SAND;
+                for (int y = seaLevel; y < terrainHeight; y++) {
+                    tile(x, y) = TileType::WATER;
+                }
+            }
+            
+            tile(x, terrainHeight) = top;
             
             for (int dirt = 1; dirt <= dirtLayers; dirt++) {
                 int y = terrainHeight + dirt;
                 if (y < worldHeight) {
-                    tiles[x][y] = TileType::DIRT;
+                    tile(x, y) = filler;
                 }
             }
             
             for (int y = terrainHeight + dirtLayers + 1; y < worldHeight; y++) {
-                if (stoneDist(rng) == 0) {
-                    tiles[x][y] = TileType::STONE;
-                } else {
-                    tiles[x][y] = TileType::GRAVELED_STONE;
-                }
+                tile(x, y) = HashRandom::coin(stoneStream, worldX, y) ? TileType::GRAVELED_STONE : TileType::STONE;
             }
         }
     }
     
     // Add bedrock at the bottom
     for (int x = 0; x < chunkWidth; x++) {
-        tiles[x][worldHeight - 1] = TileType::BEDROCK;
+        setTileUnchecked(x, worldHeight - 1, TileType::BEDROCK);
     }
 }
 
-void Chunk::generateTrees(uint64_t seed, int /*worldOffset*/) {
-    std::mt19937 rng(seed + chunkX); // Use chunk position to vary the seed
-    std::uniform_int_distribution<int> treeDist(0, 100); // Probability of tree generation
-    std::uniform_int_distribution<int> heightDist(4, 6); // Tree height variation (4-6 blocks tall)
+void Chunk::generateOres(const int* heights, const float* richness, uint64_t seed, int worldOffset) {
+    // Ores from rarest to most common, each found from a depth down. Chances are per
+    // 2x2 vein block at full richness.
+    struct OreLayer {
+        TileType type;
+        int minY;
+        double chance;
+    };
+    const OreLayer layers[] = {
+        {TileType::DIAMOND_ORE, static_cast<int>(worldHeight * 0.9), 0.006},
+        {TileType::GOLD_ORE, static_cast<int>(worldHeight * 0.75), 0.012},
+        {TileType::IRON_ORE, static_cast<int>(worldHeight * 0.55), 0.025},
+        {TileType::COAL_ORE, 0, 0.04}
+    };
     
-    // Find suitable positions for trees (on grass blocks)
-    // Don't place trees at the chunk edges to avoid issues with leaves crossing chunks
-    for (int x = 2; x < chunkWidth - 2; x++) {
-        // Only place a tree if random chance is met (about 8%)
-        if (treeDist(rng) > 92) {
-            // Find the ground level at this x position
-            for (int y = 0; y < worldHeight; y++) {
-                if (tiles[x][y] == TileType::GRASS) {
-                    // Place a tree at this position if there's enough room above
-                    int treeHeight = heightDist(rng);
-                    if (y - treeHeight >= 4) { // Ensure enough space for trunk and leaves
-                        // Place trunk sections (vertical column)
-                        for (int i = 1; i <= treeHeight; i++) {
-                            tiles[x][y-i] = TileType::TRUNK;
-                        }
-                        
-                        // The top position of the trunk
-                        int topY = y - treeHeight;
-                        
-                        // Minecraft-style tree leaf pattern
-                        // Layer 1 (bottom) - wider layer
-                        for (int lx = x - 2; lx <= x + 2; lx++) {
-                            for (int ly = topY - 1; ly <= topY; ly++) {
-                                if (lx < 0 || lx >= chunkWidth || ly < 0 || ly >= worldHeight) continue;
-                                
-                                // Skip some corner blocks for more natural shape
-                                if ((lx == x - 2 || lx == x + 2) && treeDist(rng) < 40) continue;
-                                
-                                if (tiles[lx][ly] == TileType::AIR) {
-                                    tiles[lx][ly] = TileType::LEAVES;
-                                }
-                            }
-                        }
-                        
-                        // Layer 2 (middle) - full layer
-                        for (int lx = x - 2; lx <= x + 2; lx++) {
-                            if (lx < 0 || lx >= chunkWidth) continue;
-                            
-                            int ly = topY - 2;
-                            if (ly < 0 || ly >= worldHeight) continue;
-                            
-                            // Make corners a bit more sparse
-                            if ((lx == x - 2 || lx == x + 2) && (treeDist(rng) < 30)) continue;
-                            
-                            if (tiles[lx][ly] == TileType::AIR) {
-                                tiles[lx][ly] = TileType::LEAVES;
-                            }
-                        }
-                        
-                        // Layer 3 (top) - smaller layer
-                        for (int lx = x - 1; lx <= x + 1; lx++) {
-                            if (lx < 0 || lx >= chunkWidth) continue;
-                            
-                            int ly = topY - 3;
-                            if (ly < 0 || ly >= worldHeight) continue;
-                            
-                            if (tiles[lx][ly] == TileType::AIR) {
-                                tiles[lx][ly] = TileType::LEAVES;
-                            }
-                        }
-                        
-                        // Top leaf
-                        if (topY - 4 >= 0) {
-                            tiles[x][topY - 4] = TileType::LEAVES;
-                        }
+    // Veins are picked per 2x2 block, then each tile of a vein is kept with a 3 in 4 chance
+    const uint64_t veinStream = HashRandom::streamKey(seed, RandomPurpose::ORE_VEIN);
+    const uint64_t shapeStream = HashRandom::streamKey(seed, RandomPurpose::ORE_SHAPE);
+    const int cellsWide = (chunkWidth + BiomeMap::CELL_SIZE - 1) / BiomeMap::CELL_SIZE;
+    
+    for (int x = 0; x < chunkWidth; x++) {
+        int worldX = worldOffset + x;
+        
+        for (int y = std::max(0, heights[x]); y < worldHeight; y++) {
+            float cellRichness = richness[(y / BiomeMap::CELL_SIZE) * cellsWide + x / BiomeMap::CELL_SIZE];
+            if (cellRichness <= 0.0f) {
+                continue;
+            }
+            
+            TileType current = tileAt(x, y);
+            if (current != TileType::STONE && current != TileType::GRAVELED_STONE) {
+                continue;
+            }
+            
+            // Uniform [0, 1) from the top 53 bits
+            double roll = (HashRandom::hash(veinStream, worldX >> 1, y >> 1) >> 11) * (1.0 / 9007199254740992.0);
+            double cumulative = 0.0;
+            for (const OreLayer& layer : layers) {
+                if (y < layer.minY) {
+                    continue;
+                }
+                cumulative += layer.chance * cellRichness;
+                if (roll < cumulative) {
+                    if (HashRandom::range(shapeStream, worldX, y, 0, 3) != 0) {
+                        setTileUnchecked(x, y, layer.type);
                     }
-                    break; // Stop after finding the ground level
+                    break;
                 }
             }
         }
     }
 }
 
-void Chunk::buildSpriteArray() {
-    sprites.clear();
-    sprites.reserve(chunkWidth * worldHeight); // Reserve space for efficiency
+int Chunk::generateCaves(const PerlinNoise& noise, const int* heights, int worldOffset) {
+    std::vector<uint32_t> cells;
+    findCaves(noise, heights, worldOffset, cells);
+    carveCaves(cells);
+    return static_cast<int>(cells.size());
+}
+
+void Chunk::findCaves(const PerlinNoise& noise, const int* heights, int worldOffset,
+                      std::vector<uint32_t>& cells) const {
+    // Parameters for cave generation
+    const double scale = 0.06;
+    const float threshold = 0.4f;     // caveNoise above this is carved
+    const int sectionTiles = chunkWidth * SECTION_HEIGHT;
     
-    // Calculate the world X position of this chunk in pixels
-    int worldPosX = chunkX * chunkWidth * tileSize;
+    // Cells of one section, evaluated as a single batch
+    std::vector<float> sampleX(sectionTiles);
+    std::vector<float> sampleY(sectionTiles);
+    std::vector<uint32_t> cell(sectionTiles);
+    std::vector<uint8_t> carve(sectionTiles);
     
-    // Create a sprite for each tile
-    for (int x = 0; x < chunkWidth; x++) {
-        for (int y = 0; y < worldHeight; y++) {
-            if (tiles[x][y] != TileType::AIR) {
-                sf::Sprite sprite;
-                
-                switch (tiles[x][y]) {
-                    case TileType::GRASS:
-                        sprite.setTexture(*grassTexture);
-                        break;
-                    case TileType::DIRT:
-                        sprite.setTexture(*dirtTexture);
-                        break;
-                    case TileType::STONE:
-                        sprite.setTexture(*stoneTexture);
-                        break;
-                    case TileType::GRAVELED_STONE:
-                        sprite.setTexture(*graveledStoneTexture);
-                        break;
-                    case TileType::BEDROCK:
-                        sprite.setTexture(*stoneTexture);
-                        break;
-                    case TileType::TRUNK:
-                        sprite.setTexture(*trunkTexture);
-                        break;
-                    case TileType::LEAVES:
-                        sprite.setTexture(*leavesTexture);
-                        break;
-                    default:
-                        continue; // Skip air tiles
-                }
-                
-                // Scale sprite to match tile size
-                float scaleX = static_cast<float>(tileSize) / sprite.getTexture()->getSize().x;
-                float scaleY = static_cast<float>(tileSize) / sprite.getTexture()->getSize().y;
-                sprite.setScale(scaleX, scaleY);
-                
-                // Position the sprite in the world
-                sprite.setPosition(worldPosX + x * tileSize, y * tileSize);
-                
-                sprites.push_back(sprite);
+    cells.clear();
+    for (size_t s = 0; s < sections.size(); s++) {
+        int sectionTop = static_cast<int>(s) << SECTION_SHIFT;
+        int sectionBottom = std::min(sectionTop + SECTION_HEIGHT, worldHeight - 1);  // Keep bedrock
+        
+        // Gather the cells deep enough to carve
+        size_t count = 0;
+        for (int x = 0; x < chunkWidth; x++) {
+            int top = std::max(sectionTop, heights[x] + CAVE_ROOF_DEPTH);
+            for (int y = top; y < sectionBottom; y++) {
+                sampleX[count] = static_cast<float>((worldOffset + x) * scale);
+                sampleY[count] = static_cast<float>(y * scale);
+                cell[count] = static_cast<uint32_t>(x) << 16 | static_cast<uint32_t>(y);
+                count++;
+            }
+        }
+        
+        // Sky and surface sections have nothing to evaluate, and solid ones nothing to carve
+        if (count == 0 || noise.caveMask(sampleX.data(), sampleY.data(), 0.0f, threshold,
+                                         carve.data(), count) == 0) {
+            continue;
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            if (carve[i]) {
+                cells.push_back(cell[i]);
             }
         }
     }
 }
 
-void Chunk::draw(sf::RenderWindow& window) {
-    if (!isGenerated) return;
-    
-    // Get the view to determine what's visible
-    sf::View view = window.getView();
-    float viewLeft = view.getCenter().x - view.getSize().x / 2;
-    float viewRight = view.getCenter().x + view.getSize().x / 2;
-    
-    // Simple frustum culling - only draw if chunk is in view
-    int chunkWorldPosX = chunkX * chunkWidth * tileSize;
-    int chunkWorldPosRight = chunkWorldPosX + chunkWidth * tileSize;
-    
-    if (chunkWorldPosRight < viewLeft || chunkWorldPosX > viewRight) {
-        return; // Chunk is not visible
+void Chunk::carveCaves(const std::vector<uint32_t>& cells) {
+    for (uint32_t packed : cells) {
+        setTileUnchecked(static_cast<int>(packed >> 16), static_cast<int>(packed & 0xFFFF), TileType::AIR);
     }
+}
+
+void Chunk::generateTrees(const int* heights, uint64_t seed, int worldOffset, std::vector<TileWrite>& overflow) {
+    // Every random choice is hashed from world coordinates, so a tree only depends on where it is
+    const uint64_t spawnStream = HashRandom::streamKey(seed, RandomPurpose::TREE_SPAWN);
+    const uint64_t heightStream = HashRandom::streamKey(seed, RandomPurpose::TREE_HEIGHT);
+    const uint64_t cornerStream = HashRandom::streamKey(seed, RandomPurpose::LEAF_CORNER);
     
-    // Draw all sprites in the chunk
-    for (const auto& sprite : sprites) {
-        window.draw(sprite);
+    // Leaves only grow into air; ones past the chunk edge are left for the neighbour
+    auto placeLeaf = [&](int lx, int ly) {
+        if (ly < 0 || ly >= worldHeight) return;
+        
+        if (lx < 0 || lx >= chunkWidth) {
+            overflow.push_back(TileWrite{worldOffset + lx, ly, TileType::LEAVES});
+        } else if (tileAt(lx, ly) == TileType::AIR) {
+            setTileUnchecked(lx, ly, TileType::LEAVES);
+        }
+    };
+    
+    // Find suitable positions for trees (on grass blocks)
+    for (int x = 0; x < chunkWidth; x++) {
+        int worldX = worldOffset + x;
+        
+        // Only place a tree if random chance is met (about 8%)
+        if (HashRandom::range(spawnStream, worldX, 0, 0, 100) > 92) {
+            // The ground level at this x position comes straight from the heightmap
+            int y = heights[x];
+            if (y >= 0 && y < worldHeight && tileAt(x, y) == TileType::GRASS) {
+                // Place a tree at this position if there's enough room above
+                int treeHeight = HashRandom::range(heightStream, worldX, 0, 4, 6); // 4-6 blocks tall
+                if (y - treeHeight >= 4) { // Ensure enough space for trunk and leaves
+                    // Place trunk sections (vertical column)
+                    for (int i = 1; i <= treeHeight; i++) {
+                        setTileUnchecked(x, y - i, TileType::TRUNK);
+                    }
+                    
+                    // The top position of the trunk
+                    int topY = y - treeHeight;
+                    
+                    // Minecraft-style tree leaf pattern
+                    // Layer 1 (bottom) - wider layer
+                    for (int lx = x - 2; lx <= x + 2; lx++) {
+                        for (int ly = topY - 1; ly <= topY; ly++) {
+                            // Skip some corner blocks for more natural shape
+                            if ((lx == x - 2 || lx == x + 2) && 
+                                HashRandom::range(cornerStream, worldOffset + lx, ly, 0, 100) < 40) continue;
+                            
+                            placeLeaf(lx, ly);
+                        }
+                    }
+                    
+                    // Layer 2 (middle) - full layer
+                    for (int lx = x - 2; lx <= x + 2; lx++) {
+                        int ly = topY - 2;
+                        
+                        // Make corners a bit more sparse
+                        if ((lx == x - 2 || lx == x + 2) && 
+                            (HashRandom::range(cornerStream, worldOffset + lx, ly, 0, 100) < 30)) continue;
+                        
+                        placeLeaf(lx, ly);
+                    }
+                    
+                    // Layer 3 (top) - smaller layer
+                    for (int lx = x - 1; lx <= x + 1; lx++) {
+                        placeLeaf(lx, topY - 3);
+                    }
+                    
+                    // Top leaf
+                    if (topY - 4 >= 0) {
+                        setTileUnchecked(x, topY - 4, TileType::LEAVES);
+                    }
+                }
+            }
+        }
     }
-} 
\ No newline at end of file
+}
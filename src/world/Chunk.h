@@ -1,43 +1,151 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 #include "../engine/PerlinNoise.h"
 #include "TileTypes.h"
+#include "BiomeMap.h"
+#include "SurfaceIndex.h"
+
+// A fixed-height horizontal slice of a chunk. Sections that are a single tile type
+// (most commonly the air above the surface) store just that value.
+struct ChunkSection {
+    TileType uniform = TileType::AIR;  // Type of every tile while data is empty
+    std::vector<TileType> data;        // chunkWidth * SECTION_HEIGHT tiles, column-major, when mixed
+    
+    bool isUniform() const { return data.empty(); }
+    bool isEmpty() const { return data.empty() && uniform == TileType::AIR; }
+};
+
+// A tile generation wanted to place outside the chunk being generated (e.g. part of a
+// tree canopy hanging over the edge). Only ever fills AIR in the target chunk.
+struct TileWrite {
+    int worldX;
+    int y;
+    TileType type;
+    
+    bool operator==(const TileWrite& other) const {
+        return worldX == other.worldX && y == other.y && type == other.type;
+    }
+};
 
 class Chunk {
+public:
+    static constexpr int SECTION_HEIGHT = 16;  // Rows per section
+    static constexpr int SECTION_SHIFT = 4;    // log2(SECTION_HEIGHT)
+    static constexpr int CAVE_ROOF_DEPTH = 6;  // Rows below the grass caves never carve
+
 private:
     int chunkX;        // Chunk X position in world (chunk index)
     int chunkWidth;    // Width of chunk (16 blocks)
     int worldHeight;   // Height of chunk (same as world height)
-    int tileSize;      // Size of a tile in pixels
     bool isGenerated;  // Whether this chunk has been generated
+    uint64_t revision; // Changes whenever the tiles do, so renderers know their copy is stale
+    
+    // Tiles split into vertical sections of SECTION_HEIGHT rows, top to bottom
+    std::vector<ChunkSection> sections;
     
-    std::vector<std::vector<TileType>> tiles; // 2D array of tiles in this chunk
-    std::vector<sf::Sprite> sprites;          // Sprites for rendering
+    // The revision at which each section, or a row bordering it, last changed, so a
+    // single edit only invalidates what was derived from the sections around it.
+    // Kept while the chunk is compacted.
+    std::vector<uint64_t> sectionRevisions;
     
-    sf::Texture* grassTexture;
-    sf::Texture* dirtTexture;
-    sf::Texture* stoneTexture;
-    sf::Texture* graveledStoneTexture;
-    sf::Texture* trunkTexture;
-    sf::Texture* leavesTexture;
+    // Run-length encoded (type, count) pairs holding the tiles while the chunk is compacted
+    std::vector<uint8_t> compressedTiles;
     
-    void generateTerrain(PerlinNoise& terrainNoise, uint64_t seed, int worldOffset);
-    void generateTrees(uint64_t seed, int worldOffset);
-    void buildSpriteArray();
+    // A value no chunk has had before (revisions are unique across all chunks)
+    static uint64_t nextRevision();
+    
+    // Give a uniform section its own tile buffer so individual tiles can differ
+    void makeDense(ChunkSection& section);
+    // Collapse dense sections whose tiles all ended up the same type
+    void collapseUniformSections();
+    
+    // Move the chunk and the sections around row y on to a new revision
+    void touchRow(int y) {
+        revision = nextRevision();
+        const int section = y >> SECTION_SHIFT;
+        const int row = y & (SECTION_HEIGHT - 1);
+        sectionRevisions[section] = revision;
+        if (row == 0 && section > 0) {
+            sectionRevisions[section - 1] = revision;
+        }
+        if (row == SECTION_HEIGHT - 1 && section + 1 < static_cast<int>(sectionRevisions.size())) {
+            sectionRevisions[section + 1] = revision;
+        }
+    }
 
 public:
-    Chunk(int x, int width, int height, int tileSize, 
-          sf::Texture* grass, sf::Texture* dirt, sf::Texture* stone, 
-          sf::Texture* graveledStone, sf::Texture* trunk, sf::Texture* leaves);
+    Chunk(int x, int width, int height);
+    
+    // Generation steps, normally run in order by the GenerationPipeline.
+    // heights holds the grass row of each column, from the world's surface index.
+    // biomes holds each column's biome; ground below seaLevel is covered with water.
+    void generateTerrain(const int* heights, const Biome* biomes, int seaLevel,
+                         uint64_t seed, int worldOffset);
+    // Scatter ore through the stone; richness is the BiomeMap ore field for this chunk
+    void generateOres(const int* heights, const float* richness, uint64_t seed, int worldOffset);
+    // Carve air pockets out of the stone below the dirt; returns how many tiles were carved
+    int generateCaves(const PerlinNoise& noise, const int* heights, int worldOffset);
+    // The two halves of generateCaves: find the tiles to carve, packed as (x << 16) | y,
+    // then carve them
+    void findCaves(const PerlinNoise& noise, const int* heights, int worldOffset,
+                   std::vector<uint32_t>& cells) const;
+    void carveCaves(const std::vector<uint32_t>& cells);
+    // Leaves that land in a neighbouring chunk are appended to overflow instead
+    void generateTrees(const int* heights, uint64_t seed, int worldOffset, std::vector<TileWrite>& overflow);
+    // Collapse uniform sections and mark the chunk ready to use
+    void finishGeneration();
+    
+    // Bounds-checked tile access (out of range reads return AIR, writes are ignored).
+    // Edits through setTile give the chunk, and the sections the tile touches, a new revision.
+    bool inBounds(int x, int y) const { return x >= 0 && x < chunkWidth && y >= 0 && y < worldHeight; }
+    TileType getTile(int x, int y) const { return inBounds(x, y) ? tileAt(x, y) : TileType::AIR; }
+    void setTile(int x, int y, TileType type) {
+        if (inBounds(x, y) && tileAt(x, y) != type) {
+            setTileUnchecked(x, y, type);
+            touchRow(y);
+        }
+    }
     
-    void generate(PerlinNoise& terrainNoise, uint64_t seed, int worldOffset);
-    void draw(sf::RenderWindow& window);
+    // Unchecked tile access for hot loops - caller guarantees the coordinates are valid.
+    // Doesn't touch the revision: call markChanged() once the batch of edits is done.
+    TileType tileAt(int x, int y) const {
+        const ChunkSection& section = sections[y >> SECTION_SHIFT];
+        return section.isUniform() ? section.uniform 
+                                   : section.data[x * SECTION_HEIGHT + (y & (SECTION_HEIGHT - 1))];
+    }
+    void setTileUnchecked(int x, int y, TileType type) {
+        ChunkSection& section = sections[y >> SECTION_SHIFT];
+        if (section.isUniform()) {
+            if (section.uniform == type) return;
+            makeDense(section);
+        }
+        section.data[x * SECTION_HEIGHT + (y & (SECTION_HEIGHT - 1))] = type;
+    }
+    
+    // New revision for the whole chunk and every section in it
+    void markChanged() {
+        revision = nextRevision();
+        sectionRevisions.assign(sectionRevisions.size(), revision);
+    }
+    uint64_t getRevision() const { return revision; }
+    uint64_t getSectionRevision(int index) const { return sectionRevisions[index]; }
+    
+    // Section access for passes that can skip whole uniform sections
+    int getSectionCount() const { return static_cast<int>(sections.size()); }
+    const ChunkSection& getSection(int index) const { return sections[index]; }
     
     int getChunkX() const { return chunkX; }
     int getWorldX() const { return chunkX * chunkWidth; }
     int getWidth() const { return chunkWidth; }
+    int getHeight() const { return worldHeight; }
     bool isActive() const { return isGenerated; }
-    void unload() { sprites.clear(); isGenerated = false; }
+    size_t getMemoryUsage() const;
+    
+    // Shrink an evicted chunk to run-length encoded tiles
+    void compact();
+    // Restore a compacted chunk's sections so its tiles can be read again
+    void expand();
+    bool isCompact() const { return sections.empty() && !compressedTiles.empty(); }
 }; 
\ No newline at end of file
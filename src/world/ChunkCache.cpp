@@ -0,0 +1,66 @@
+#include "ChunkCache.h"
+
+ChunkCache::ChunkCache(size_t budgetBytes) :
+    budgetBytes(budgetBytes),
+    usedBytes(0),
+    hits(0),
+    misses(0),
+    evictions(0) {
+}
+
+void ChunkCache::put(std::unique_ptr<Chunk> chunk) {
+    if (!chunk || !chunk->isActive()) {
+        return;
+    }
+    
+    // Replace any stale copy of the same chunk
+    auto existing = index.find(chunk->getChunkX());
+    if (existing != index.end()) {
+        usedBytes -= (*existing->second)->getMemoryUsage();
+        entries.erase(existing->second);
+        index.erase(existing);
+    }
+    
+    chunk->compact();
+    usedBytes += chunk->getMemoryUsage();
+    
+    int chunkX = chunk->getChunkX();
+    entries.push_front(std::move(chunk));
+    index[chunkX] = entries.begin();
+    
+    evictToBudget();
+}
+
+std::unique_ptr<Chunk> ChunkCache::take(int chunkX) {
+    auto it = index.find(chunkX);
+    if (it == index.end()) {
+        misses++;
+        return nullptr;
+    }
+    
+    std::unique_ptr<Chunk> chunk = std::move(*it->second);
+    usedBytes -= chunk->getMemoryUsage();
+    entries.erase(it->second);
+    index.erase(it);
+    hits++;
+    
+    chunk->expand();
+    return chunk;
+}
+
+void ChunkCache::clear() {
+    entries.clear();
+    index.clear();
+    usedBytes = 0;
+}
+
+void ChunkCache::evictToBudget() {
+    // Drop least recently used chunks until we fit
+    while (usedBytes > budgetBytes && !entries.empty()) {
+        const std::unique_ptr<Chunk>& oldest = entries.back();
+        usedBytes -= oldest->getMemoryUsage();
+        index.erase(oldest->getChunkX());
+        entries.pop_back();
+        evictions++;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include "Chunk.h"
+
+// Bounded LRU cache of chunks that left the active window.
+// Evicted chunks are compacted to run-length encoded tiles and kept until the memory budget is exceeded, so walking back over a boundary
+// restores them instead of regenerating from noise.
+class ChunkCache {
+private:
+    // Most recently used chunk at the front
+    std::list<std::unique_ptr<Chunk>> entries;
+    std::unordered_map<int, std::list<std::unique_ptr<Chunk>>::iterator> index;
+    
+    size_t budgetBytes;
+    size_t usedBytes;
+    
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    
+    void evictToBudget();
+
+public:
+    static const size_t DEFAULT_BUDGET_BYTES = 32 * 1024 * 1024;
+    
+    explicit ChunkCache(size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+    
+    // Take ownership of a chunk leaving the active window
+    void put(std::unique_ptr<Chunk> chunk);
+    
+    // Remove and return a cached chunk ready to use, or nullptr on a miss
+    std::unique_ptr<Chunk> take(int chunkX);
+    
+    bool contains(int chunkX) const { return index.count(chunkX) != 0; }
+    
+    // Forget everything (e.g. when the world seed changes)
+    void clear();
+    
+    void setBudget(size_t bytes) { budgetBytes = bytes; evictToBudget(); }
+    
+    size_t getBudget() const { return budgetBytes; }
+    size_t getMemoryUsage() const { return usedBytes; }
+    size_t size() const { return entries.size(); }
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+    uint64_t getEvictions() const { return evictions; }
+};
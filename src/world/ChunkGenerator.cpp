@@ -0,0 +1,115 @@
+#include "ChunkGenerator.h"
+#include <algorithm>
+#include <cstdlib>
+
+ChunkGenerator::ChunkGenerator(int chunkWidth, int worldHeight, unsigned int threadCount) :
+    chunkWidth(chunkWidth),
+    worldHeight(worldHeight),
+    centerChunkX(0),
+    stopping(false)
+{
+    pipeline.addDefaultStages();
+    
+    if (threadCount == 0) {
+        unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+    
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ChunkGenerator::workerLoop, this);
+    }
+}
+
+ChunkGenerator::~ChunkGenerator() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+        queue.clear();
+    }
+    queueCondition.notify_all();
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    // Free anything that finished but was never collected
+    completed.popAll([](Result&&) {});
+}
+
+bool ChunkGenerator::isFarther(const Job& a, const Job& b) const {
+    return std::abs(a.chunkX - centerChunkX) > std::abs(b.chunkX - centerChunkX);
+}
+
+void ChunkGenerator::request(int chunkX, uint64_t epoch, std::shared_ptr<SurfaceIndex> surface,
+                             std::shared_ptr<BiomeMap> biomes, uint64_t seed) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(Job{chunkX, epoch, seed, std::move(surface), std::move(biomes)});
+        std::push_heap(queue.begin(), queue.end(),
+                       [this](const Job& a, const Job& b) { return isFarther(a, b); });
+    }
+    queueCondition.notify_one();
+}
+
+void ChunkGenerator::setCenter(int chunkX) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (chunkX == centerChunkX) {
+        return;
+    }
+    
+    centerChunkX = chunkX;
+    std::make_heap(queue.begin(), queue.end(),
+                   [this](const Job& a, const Job& b) { return isFarther(a, b); });
+}
+
+void ChunkGenerator::cancelOutside(int minChunkX, int maxChunkX, std::vector<int>& cancelled) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    
+    auto outside = [&](const Job& job) { return job.chunkX < minChunkX || job.chunkX > maxChunkX; };
+    for (const Job& job : queue) {
+        if (outside(job)) {
+            cancelled.push_back(job.chunkX);
+        }
+    }
+    
+    auto newEnd = std::remove_if(queue.begin(), queue.end(), outside);
+    if (newEnd != queue.end()) {
+        queue.erase(newEnd, queue.end());
+        std::make_heap(queue.begin(), queue.end(),
+                       [this](const Job& a, const Job& b) { return isFarther(a, b); });
+    }
+}
+
+void ChunkGenerator::clear() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queue.clear();
+}
+
+size_t ChunkGenerator::getQueuedCount() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return queue.size();
+}
+
+void ChunkGenerator::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+            
+            std::pop_heap(queue.begin(), queue.end(),
+                          [this](const Job& a, const Job& b) { return isFarther(a, b); });
+            job = std::move(queue.back());
+            queue.pop_back();
+        }
+        
+        // Generate outside the lock so workers run in parallel
+        auto chunk = std::make_unique<Chunk>(job.chunkX, chunkWidth, worldHeight);
+        std::vector<TileWrite> overflow = pipeline.generate(*chunk, *job.surface, *job.biomes, job.seed);
+        completed.push(Result{std::move(chunk), job.epoch, std::move(overflow)});
+    }
+}
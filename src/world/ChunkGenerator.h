@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
+#include "../engine/MpscQueue.h"
+#include "../engine/PerlinNoise.h"
+#include "BiomeMap.h"
+#include "Chunk.h"
+#include "GenerationPipeline.h"
+#include "SurfaceIndex.h"
+
+// Background worker pool that runs the generation pipeline for chunks off the main thread.
+// Requests are served nearest-first relative to the camera centre chunk, and finished chunks
+// are handed back through a lock-free queue that the main thread drains once per frame.
+class ChunkGenerator {
+public:
+    // A finished chunk together with the world generation it was requested for
+    struct Result {
+        std::unique_ptr<Chunk> chunk;
+        uint64_t epoch;
+        std::vector<TileWrite> overflow;  // Tiles it placed in neighbouring chunks
+    };
+
+private:
+    struct Job {
+        int chunkX;
+        uint64_t epoch;
+        uint64_t seed;
+        std::shared_ptr<SurfaceIndex> surface;
+        std::shared_ptr<BiomeMap> biomes;
+    };
+    
+    int chunkWidth;
+    int worldHeight;
+    
+    // Stages every chunk goes through; fixed once the workers start
+    GenerationPipeline pipeline;
+    
+    std::vector<std::thread> workers;
+    
+    // Pending jobs kept as a binary heap with the job closest to centerChunkX on top
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::vector<Job> queue;
+    int centerChunkX;
+    bool stopping;
+    
+    // Completed chunks, pushed by workers and drained by the main thread
+    MpscQueue<Result> completed;
+    
+    void workerLoop();
+    
+    // Heap ordering: a sorts below b when it is farther from the centre
+    bool isFarther(const Job& a, const Job& b) const;
+
+public:
+    // threadCount 0 picks one thread per core, leaving a core for the main thread
+    ChunkGenerator(int chunkWidth, int worldHeight, unsigned int threadCount = 0);
+    ~ChunkGenerator();
+    
+    ChunkGenerator(const ChunkGenerator&) = delete;
+    ChunkGenerator& operator=(const ChunkGenerator&) = delete;
+    
+    // Queue a chunk for generation against the given seed's surface index and biome map
+    void request(int chunkX, uint64_t epoch, std::shared_ptr<SurfaceIndex> surface,
+                 std::shared_ptr<BiomeMap> biomes, uint64_t seed);
+    
+    // Move the priority centre; queued jobs are re-ordered by their new distance
+    void setCenter(int chunkX);
+    
+    // Drop queued jobs outside [minChunkX, maxChunkX] and report which chunks were cancelled
+    void cancelOutside(int minChunkX, int maxChunkX, std::vector<int>& cancelled);
+    
+    // Drop every queued job (jobs already running still complete)
+    void clear();
+    
+    // Main thread only: pass every finished chunk to fn, returns how many were collected
+    template <typename Fn>
+    size_t collect(Fn&& fn) { return completed.popAll(std::forward<Fn>(fn)); }
+    
+    size_t getQueuedCount();
+    const GenerationPipeline& getPipeline() const { return pipeline; }
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()); }
+};
@@ -0,0 +1,70 @@
+#include "ChunkWindow.h"
+
+ChunkWindow::ChunkWindow(int minCapacity) : mask(0), count(0) {
+    int capacity = roundUpToPowerOfTwo(minCapacity);
+    slots.resize(capacity);
+    mask = capacity - 1;
+}
+
+int ChunkWindow::roundUpToPowerOfTwo(int value) {
+    int capacity = 1;
+    while (capacity < value) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+std::vector<std::unique_ptr<Chunk>> ChunkWindow::reserve(int minCapacity, int centerChunkX) {
+    std::vector<std::unique_ptr<Chunk>> displaced;
+    int capacity = roundUpToPowerOfTwo(minCapacity);
+    if (capacity == mask + 1) {
+        return displaced;
+    }
+    
+    std::vector<std::unique_ptr<Chunk>> oldSlots(capacity);
+    oldSlots.swap(slots);
+    mask = capacity - 1;
+    count = 0;
+    
+    // Re-slot under the new mask. Only a run of capacity chunks can be held at once, so
+    // anything outside the run centred on centerChunkX goes back to the caller.
+    const int firstKept = centerChunkX - (capacity - 1) / 2;
+    const int lastKept = firstKept + capacity - 1;
+    for (auto& chunk : oldSlots) {
+        if (!chunk) {
+            continue;
+        }
+        if (chunk->getChunkX() < firstKept || chunk->getChunkX() > lastKept) {
+            displaced.push_back(std::move(chunk));
+        } else if (std::unique_ptr<Chunk> collided = insert(std::move(chunk))) {
+            displaced.push_back(std::move(collided));
+        }
+    }
+    return displaced;
+}
+
+std::unique_ptr<Chunk> ChunkWindow::insert(std::unique_ptr<Chunk> chunk) {
+    std::unique_ptr<Chunk>& slot = slots[chunk->getChunkX() & mask];
+    std::unique_ptr<Chunk> displaced = std::move(slot);
+    if (!displaced) {
+        count++;
+    }
+    slot = std::move(chunk);
+    return displaced;
+}
+
+std::unique_ptr<Chunk> ChunkWindow::remove(int chunkX) {
+    std::unique_ptr<Chunk>& slot = slots[chunkX & mask];
+    if (!slot || slot->getChunkX() != chunkX) {
+        return nullptr;
+    }
+    count--;
+    return std::move(slot);
+}
+
+void ChunkWindow::clear() {
+    for (auto& slot : slots) {
+        slot.reset();
+    }
+    count = 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "Chunk.h"
+
+// Fixed-capacity ring buffer of loaded chunks, indexed by chunkX mod capacity.
+// The loaded set is always a contiguous run of chunk indices narrower than the
+// capacity, so each slot holds at most one live chunk and lookups are a mask.
+class ChunkWindow {
+private:
+    std::vector<std::unique_ptr<Chunk>> slots;
+    int mask;          // capacity - 1 (capacity is a power of two)
+    size_t count;      // Number of occupied slots
+    
+    static int roundUpToPowerOfTwo(int value);
+
+public:
+    explicit ChunkWindow(int minCapacity = 16);
+    
+    // Grow or shrink to hold at least minCapacity chunks, re-slotting what is loaded.
+    // When the loaded span no longer fits, the chunks nearest centerChunkX stay and the
+    // rest are handed back so the caller can keep them elsewhere.
+    std::vector<std::unique_ptr<Chunk>> reserve(int minCapacity, int centerChunkX);
+    
+    // O(1) lookup, nullptr when that chunk isn't loaded
+    Chunk* get(int chunkX) const {
+        const std::unique_ptr<Chunk>& slot = slots[chunkX & mask];
+        return (slot && slot->getChunkX() == chunkX) ? slot.get() : nullptr;
+    }
+    bool contains(int chunkX) const { return get(chunkX) != nullptr; }
+    
+    // Store a chunk in its slot. Returns whatever chunk previously occupied the slot
+    // (nullptr normally) so the caller can decide what to do with it.
+    std::unique_ptr<Chunk> insert(std::unique_ptr<Chunk> chunk);
+    
+    // Take a chunk out of the window, nullptr if it wasn't loaded
+    std::unique_ptr<Chunk> remove(int chunkX);
+    
+    void clear();
+    
+    // Visit loaded chunks from startChunkX to endChunkX in order
+    template <typename Fn>
+    void forEachInRange(int startChunkX, int endChunkX, Fn&& fn) const {
+        for (int x = startChunkX; x <= endChunkX; x++) {
+            if (Chunk* chunk = get(x)) {
+                fn(*chunk);
+            }
+        }
+    }
+    
+    // Visit every loaded chunk in slot order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& slot : slots) {
+            if (slot) {
+                fn(*slot);
+            }
+        }
+    }
+    
+    // Remove every chunk for which pred returns true, handing each one to sink
+    template <typename Pred, typename Sink>
+    void removeIf(Pred&& pred, Sink&& sink) {
+        for (auto& slot : slots) {
+            if (slot && pred(*slot)) {
+                std::unique_ptr<Chunk> chunk = std::move(slot);
+                count--;
+                sink(std::move(chunk));
+            }
+        }
+    }
+    
+    int capacity() const { return mask + 1; }
+    size_t size() const { return count; }
+};
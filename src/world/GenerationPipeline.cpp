@@ -0,0 +1,177 @@
+#include "GenerationPipeline.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+int histogramBucket(uint64_t nanoseconds) {
+    uint64_t microseconds = nanoseconds / 1000;
+    int bucket = 0;
+    while (microseconds > 0 && bucket < GenerationPipeline::HISTOGRAM_BUCKETS - 1) {
+        microseconds >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+} // namespace
+
+uint64_t GenerationPipeline::StageReport::percentileMicroseconds(double fraction) const {
+    uint64_t target = static_cast<uint64_t>(runs * fraction);
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += histogram[i];
+        if (seen > target) {
+            return static_cast<uint64_t>(1) << i;
+        }
+    }
+    return static_cast<uint64_t>(1) << (HISTOGRAM_BUCKETS - 1);
+}
+
+void GenerationPipeline::addStage(GenerationStage stage) {
+    stages.push_back(Entry{std::move(stage), std::make_unique<Timings>()});
+}
+
+void GenerationPipeline::addDefaultStages() {
+    addStage({"terrain", 0, nullptr, [](GenerationContext& context) {
+        context.chunk.generateTerrain(context.heights.data(), context.columnBiomes.data(),
+                                      context.biomes.getSeaLevel(), context.seed, context.worldOffset);
+    }});
+
+    // Air pockets in the stone; the surface itself is never carved, so the index stays right.
+    // No cheap test rules caves out (about 1% of chunks carve nothing), so the predicate does
+    // the noise pass and the stage only runs when it found tiles to carve.
+    addStage({"caves", 0, [](GenerationContext& context) {
+        context.chunk.findCaves(context.surface.getNoise(), context.heights.data(), context.worldOffset,
+                                context.caveCells);
+        return !context.caveCells.empty();
+    }, [](GenerationContext& context) {
+        context.chunk.carveCaves(context.caveCells);
+    }});
+    
+    // Ore goes in after the caves so none is wasted on carved tiles. Chunks lying wholly
+    // in barren ground (zero richness everywhere) get none.
+    addStage({"ores", 0, [](GenerationContext& context) {
+        return std::any_of(context.oreRichness.begin(), context.oreRichness.end(),
+                           [](float richness) { return richness > 0.0f; });
+    }, [](GenerationContext& context) {
+        context.chunk.generateOres(context.heights.data(), context.oreRichness.data(), context.seed,
+                                   context.worldOffset);
+    }});
+    
+    // Canopies reach two columns past the trunk, into the chunk on either side. Trees only
+    // grow on grass, so desert, snow and lake chunks are skipped.
+    addStage({"trees", 1, [](GenerationContext& context) {
+        const Chunk& chunk = context.chunk;
+        for (int x = 0; x < chunk.getWidth(); x++) {
+            int y = context.heights[x];
+            if (y >= 0 && y < chunk.getHeight() && chunk.tileAt(x, y) == TileType::GRASS) {
+                return true;
+            }
+        }
+        return false;
+    }, [](GenerationContext& context) {
+        context.chunk.generateTrees(context.heights.data(), context.seed, context.worldOffset, context.overflow);
+    }});
+
+    // Compact the sections; meshes are built later by the renderer, from the finished tiles
+    addStage({"finish", 0, nullptr, [](GenerationContext& context) {
+        context.chunk.finishGeneration();
+    }});
+}
+
+std::vector<TileWrite> GenerationPipeline::generate(Chunk& chunk, SurfaceIndex& surface, BiomeMap& biomes,
+                                                    uint64_t seed) const {
+    using Clock = std::chrono::steady_clock;
+
+    // Terrain heights come from the shared surface index so both always agree
+    const int width = chunk.getWidth();
+    const int cellsWide = (width + BiomeMap::CELL_SIZE - 1) / BiomeMap::CELL_SIZE;
+    GenerationContext context{chunk, surface, biomes, seed, chunk.getWorldX(),
+                              std::vector<int>(width), std::vector<Biome>(width),
+                              std::vector<float>(static_cast<size_t>(cellsWide) * biomes.getCellRows()), {}, {}};
+    surface.getTerrainHeights(context.worldOffset, width, context.heights.data());
+    biomes.getBiomes(context.worldOffset, width, context.columnBiomes.data());
+    biomes.getOreRichness(context.worldOffset, width, context.oreRichness.data());
+
+    for (const Entry& entry : stages) {
+        auto start = Clock::now();
+        auto elapsedSinceStart = [start]() {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        };
+
+        if (entry.stage.applies && !entry.stage.applies(context)) {
+            entry.timings->skipped.fetch_add(1, std::memory_order_relaxed);
+            entry.timings->totalNanoseconds.fetch_add(elapsedSinceStart(), std::memory_order_relaxed);
+            continue;
+        }
+
+        entry.stage.run(context);
+        uint64_t elapsed = elapsedSinceStart();
+
+        entry.timings->runs.fetch_add(1, std::memory_order_relaxed);
+        entry.timings->totalNanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+        entry.timings->histogram[histogramBucket(elapsed)].fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    return std::move(context.overflow);
+}
+
+std::vector<GenerationPipeline::StageReport> GenerationPipeline::getReport() const {
+    std::vector<StageReport> report;
+    report.reserve(stages.size());
+    for (const Entry& entry : stages) {
+        StageReport stage;
+        stage.name = entry.stage.name;
+        stage.neighbourRadius = entry.stage.neighbourRadius;
+        stage.runs = entry.timings->runs.load(std::memory_order_relaxed);
+        stage.skipped = entry.timings->skipped.load(std::memory_order_relaxed);
+        stage.totalNanoseconds = entry.timings->totalNanoseconds.load(std::memory_order_relaxed);
+        for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            stage.histogram[i] = entry.timings->histogram[i].load(std::memory_order_relaxed);
+        }
+        report.push_back(stage);
+    }
+    return report;
+}
+
+void GenerationPipeline::printReport(std::ostream& out) const {
+    std::vector<StageReport> report = getReport();
+
+    uint64_t totalNanoseconds = 0;
+    for (const StageReport& stage : report) {
+        totalNanoseconds += stage.totalNanoseconds;
+    }
+
+    out << "Generation stages:" << std::endl;
+    for (const StageReport& stage : report) {
+        // Predicates take time too, so the average is over every chunk the stage saw
+        uint64_t chunks = stage.runs + stage.skipped;
+        double average = chunks ? stage.totalNanoseconds / 1000.0 / chunks : 0.0;
+        double share = totalNanoseconds ? 100.0 * stage.totalNanoseconds / totalNanoseconds : 0.0;
+
+        // Format each line separately so the caller's stream settings are left alone
+        std::ostringstream line;
+        line << "  " << std::left << std::setw(10) << stage.name << std::right
+             << " runs " << stage.runs << ", skipped " << stage.skipped
+             << ", avg " << std::fixed << std::setprecision(1) << average << " us"
+             << ", p50 < " << stage.percentileMicroseconds(0.5) << " us"
+             << ", p99 < " << stage.percentileMicroseconds(0.99) << " us"
+             << ", " << share << "% of total";
+        out << line.str() << std::endl;
+    }
+}
+
+void GenerationPipeline::resetTimings() {
+    for (const Entry& entry : stages) {
+        entry.timings->runs = 0;
+        entry.timings->skipped = 0;
+        entry.timings->totalNanoseconds = 0;
+        for (auto& bucket : entry.timings->histogram) {
+            bucket = 0;
+        }
+    }
+}
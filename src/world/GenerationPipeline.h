@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "BiomeMap.h"
+#include "Chunk.h"
+#include "SurfaceIndex.h"
+
+// Everything a generation stage can see while building one chunk
+struct GenerationContext {
+    Chunk& chunk;
+    SurfaceIndex& surface;
+    BiomeMap& biomes;
+    uint64_t seed;
+    int worldOffset;            // World X of the chunk's first column
+    std::vector<int> heights;   // Grass row of each column, from the surface index
+    std::vector<Biome> columnBiomes;  // Biome of each column, from the biome map
+    std::vector<float> oreRichness;   // Ore field per BiomeMap cell, row by row, from the biome map
+    std::vector<TileWrite> overflow;  // Writes that fall in neighbouring chunks
+    std::vector<uint32_t> caveCells;  // Tiles the caves stage carves, found by its predicate
+};
+
+// One step of chunk generation
+struct GenerationStage {
+    std::string name;
+    // Chunks on each side the stage reaches into (0 = own chunk only). Informational: it is
+    // only reported, nothing schedules by it; writes past the chunk go through overflow.
+    int neighbourRadius;
+    // Empty means the stage always runs. It may leave work it found in the context for run;
+    // its time counts towards the stage's, whether the stage then runs or not.
+    std::function<bool(GenerationContext&)> applies;
+    std::function<void(GenerationContext&)> run;
+};
+
+// Ordered list of generation stages run for every chunk, with a timing histogram per stage.
+// Stages are registered up front; generate() may then be called from several threads at once.
+class GenerationPipeline {
+public:
+    // Bucket i counts runs that took [2^(i-1), 2^i) microseconds (bucket 0: under 1 us)
+    static const int HISTOGRAM_BUCKETS = 20;
+
+    struct StageReport {
+        std::string name;
+        int neighbourRadius;
+        uint64_t runs;
+        uint64_t skipped;
+        uint64_t totalNanoseconds;
+        std::array<uint64_t, HISTOGRAM_BUCKETS> histogram;
+
+        // Upper bound in microseconds of the bucket holding the given fraction of runs
+        uint64_t percentileMicroseconds(double fraction) const;
+    };
+
+private:
+    struct Timings {
+        std::atomic<uint64_t> runs{0};
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<uint64_t> totalNanoseconds{0};
+        std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> histogram{};
+    };
+
+    struct Entry {
+        GenerationStage stage;
+        std::unique_ptr<Timings> timings;
+    };
+
+    std::vector<Entry> stages;
+
+public:
+    GenerationPipeline() = default;
+
+    // Register a stage after the ones already added. Not thread-safe: finish
+    // registering before the first generate() call.
+    void addStage(GenerationStage stage);
+
+    // Base terrain, caves, ores, trees and section compaction
+    void addDefaultStages();
+
+    // Run every applicable stage on a freshly constructed chunk. Returns the writes
+    // stages made outside it, for the world to deliver to the neighbours.
+    std::vector<TileWrite> generate(Chunk& chunk, SurfaceIndex& surface, BiomeMap& biomes,
+                                    uint64_t seed) const;
+
+    size_t getStageCount() const { return stages.size(); }
+
+    std::vector<StageReport> getReport() const;
+    void printReport(std::ostream& out) const;
+    void resetTimings();
+};
@@ -0,0 +1,62 @@
+#include "PendingTileWrites.h"
+
+PendingTileWrites::PendingTileWrites(int chunkShift) :
+    chunkShift(chunkShift),
+    writeCount(0) {
+}
+
+void PendingTileWrites::add(int sourceChunkX, const std::vector<TileWrite>& writes, std::vector<int>& changedTargets) {
+    if (writes.empty()) {
+        return;
+    }
+
+    // Split the writes by the chunk they land in (a chunk spills into both neighbours)
+    std::map<int, std::vector<TileWrite>> byTarget;
+    for (const TileWrite& write : writes) {
+        byTarget[write.worldX >> chunkShift].push_back(write);
+    }
+
+    for (auto& entry : byTarget) {
+        Batch& batch = targets[entry.first][sourceChunkX];
+        if (batch.writes == entry.second) {
+            continue;
+        }
+
+        writeCount += entry.second.size();
+        writeCount -= batch.writes.size();
+        batch.writes = std::move(entry.second);
+        batch.applied = false;
+        changedTargets.push_back(entry.first);
+    }
+}
+
+bool PendingTileWrites::applyTo(Chunk& chunk, bool onlyNew) {
+    auto it = targets.find(chunk.getChunkX());
+    if (it == targets.end()) {
+        return false;
+    }
+
+    const int worldOffset = chunk.getWorldX();
+    bool changed = false;
+    for (auto& entry : it->second) {
+        Batch& batch = entry.second;
+        if (onlyNew && batch.applied) {
+            continue;
+        }
+
+        for (const TileWrite& write : batch.writes) {
+            int localX = write.worldX - worldOffset;
+            if (chunk.getTile(localX, write.y) == TileType::AIR) {
+                chunk.setTile(localX, write.y, write.type);
+                changed = true;
+            }
+        }
+        batch.applied = true;
+    }
+    return changed;
+}
+
+void PendingTileWrites::clear() {
+    targets.clear();
+    writeCount = 0;
+}
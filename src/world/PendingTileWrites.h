@@ -0,0 +1,66 @@
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "Chunk.h"
+
+// Tiles generation placed across chunk edges (tree canopies), held per target chunk so
+// features can span chunks without regenerating the neighbour. Each source chunk's
+// writes into a target are kept as one batch: generation is deterministic, so a source
+// that is generated again produces the same batch and nothing needs re-applying.
+// Writes only fill AIR, so applying a batch twice or in any order gives the same tiles.
+// A target generated again from noise needs its batches again, so they are kept while
+// the target or any of its sources is loaded or cached, and dropped once none is (or
+// the seed changes). A dropped batch comes back when its source is generated again.
+// Main thread only.
+class PendingTileWrites {
+private:
+    struct Batch {
+        std::vector<TileWrite> writes;
+        bool applied = false;  // Already in the target's current copy
+    };
+
+    int chunkShift;  // log2(chunk width), world tile X -> chunk X
+
+    // Target chunk X -> source chunk X -> writes
+    std::unordered_map<int, std::map<int, Batch>> targets;
+    size_t writeCount;
+
+public:
+    explicit PendingTileWrites(int chunkShift);
+
+    // Record the writes a freshly generated chunk made outside itself. Targets whose
+    // batch is new or different are appended to changedTargets.
+    void add(int sourceChunkX, const std::vector<TileWrite>& writes, std::vector<int>& changedTargets);
+
+    // Apply the writes meant for a chunk; onlyNew skips batches its current copy already has.
+    // Returns true if any tile changed (the chunk's revision moves on).
+    bool applyTo(Chunk& chunk, bool onlyNew);
+
+    // Drop the targets that neither they nor any of their sources are resident for.
+    // isResident(chunkX) says whether a chunk is loaded, cached or on its way.
+    template <typename IsResident>
+    void prune(IsResident&& isResident) {
+        for (auto it = targets.begin(); it != targets.end();) {
+            bool needed = isResident(it->first);
+            for (auto source = it->second.begin(); !needed && source != it->second.end(); ++source) {
+                needed = isResident(source->first);
+            }
+            if (needed) {
+                ++it;
+                continue;
+            }
+
+            for (const auto& source : it->second) {
+                writeCount -= source.second.writes.size();
+            }
+            it = targets.erase(it);
+        }
+    }
+
+    void clear();
+
+    size_t getTargetCount() const { return targets.size(); }
+    size_t getWriteCount() const { return writeCount; }
+};
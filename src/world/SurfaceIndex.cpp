@@ -0,0 +1,117 @@
+#include "SurfaceIndex.h"
+#include <vector>
+
+namespace {
+
+// Block containing a column, rounding towards negative infinity
+int blockIndex(int worldX) {
+    return worldX >= 0 ? worldX / SurfaceIndex::BLOCK_COLUMNS
+                       : -((-worldX - 1) / SurfaceIndex::BLOCK_COLUMNS) - 1;
+}
+
+} // namespace
+
+SurfaceIndex::SurfaceIndex(std::shared_ptr<const PerlinNoise> noise, int worldHeight) :
+    noise(std::move(noise)),
+    worldHeight(worldHeight) {
+}
+
+void SurfaceIndex::computeTerrainHeights(const PerlinNoise& noise, int worldHeight,
+                                         int firstWorldX, int count, int* out) {
+    // Parameters for terrain generation
+    const double scale = 0.05;
+    const int baseHeight = worldHeight * 0.5;
+    const int hillHeight = worldHeight * 0.18;
+
+    // Sample the perlin noise for every column in one batch
+    std::vector<float> sampleX(count);
+    std::vector<float> sampleY(count, 0.0f);
+    std::vector<float> samples(count);
+    for (int i = 0; i < count; i++) {
+        sampleX[i] = static_cast<float>((firstWorldX + i) * scale);
+    }
+    noise.noise(sampleX.data(), sampleY.data(), samples.data(), count);
+
+    for (int i = 0; i < count; i++) {
+        double heightValue = samples[i] * 0.5 + 0.5;
+        out[i] = baseHeight - hillHeight * heightValue;
+    }
+}
+
+SurfaceIndex::Block& SurfaceIndex::getBlock(int blockX) {
+    auto it = blocks.find(blockX);
+    if (it != blocks.end()) {
+        return it->second;
+    }
+
+    int heights[BLOCK_COLUMNS];
+    computeTerrainHeights(*noise, worldHeight, blockX * BLOCK_COLUMNS, BLOCK_COLUMNS, heights);
+
+    Block& block = blocks[blockX];
+    for (int i = 0; i < BLOCK_COLUMNS; i++) {
+        block.terrain[i] = static_cast<int16_t>(heights[i]);
+        block.surface[i] = static_cast<int16_t>(heights[i]);
+    }
+    return block;
+}
+
+void SurfaceIndex::getTerrainHeights(int firstWorldX, int count, int* out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < count; i++) {
+        int worldX = firstWorldX + i;
+        int blockX = blockIndex(worldX);
+        out[i] = getBlock(blockX).terrain[worldX - blockX * BLOCK_COLUMNS];
+    }
+}
+
+int SurfaceIndex::getTerrainHeight(int worldX) {
+    int height;
+    getTerrainHeights(worldX, 1, &height);
+    return height;
+}
+
+int SurfaceIndex::surfaceY(int worldX) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int blockX = blockIndex(worldX);
+    return getBlock(blockX).surface[worldX - blockX * BLOCK_COLUMNS];
+}
+
+void SurfaceIndex::onTileChanged(int worldX, int y, TileType type, const std::function<TileType(int)>& columnTile) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int blockX = blockIndex(worldX);
+    int16_t& surface = getBlock(blockX).surface[worldX - blockX * BLOCK_COLUMNS];
+
+    if (isGround(type)) {
+        // Building above the ground raises the surface
+        if (y < surface) {
+            surface = static_cast<int16_t>(y);
+        }
+    } else if (y == surface) {
+        // The top ground tile was removed: the next ground tile below is the new surface
+        int below = y + 1;
+        while (below < worldHeight && !isGround(columnTile(below))) {
+            below++;
+        }
+        surface = static_cast<int16_t>(below);
+    }
+}
+
+void SurfaceIndex::restoreTerrain(int firstWorldX, int count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < count; i++) {
+        int worldX = firstWorldX + i;
+        int blockX = blockIndex(worldX);
+
+        // Blocks nobody has asked about yet have no edits to forget
+        auto it = blocks.find(blockX);
+        if (it != blocks.end()) {
+            int column = worldX - blockX * BLOCK_COLUMNS;
+            it->second.surface[column] = it->second.terrain[column];
+        }
+    }
+}
+
+size_t SurfaceIndex::getBlockCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return blocks.size();
+}
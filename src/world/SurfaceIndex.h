@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "../engine/PerlinNoise.h"
+#include "TileTypes.h"
+
+// World-wide heightmap for one seed, answering "where is the ground in this column"
+// in O(1). Columns are filled lazily from the terrain noise in blocks of
+// BLOCK_COLUMNS, the first time anything asks about them, and kept for as long as
+// the seed is loaded. Chunk generation reads its terrain heights from here, so the
+// index and the generated terrain always agree. Safe to share between threads.
+class SurfaceIndex {
+public:
+    static const int BLOCK_COLUMNS = 256;
+
+private:
+    struct Block {
+        std::array<int16_t, BLOCK_COLUMNS> terrain;  // Grass height straight from the noise
+        std::array<int16_t, BLOCK_COLUMNS> surface;  // Top ground tile including edits
+    };
+
+    std::shared_ptr<const PerlinNoise> noise;
+    int worldHeight;
+
+    std::unordered_map<int, Block> blocks;
+    mutable std::mutex mutex;
+
+    // Expects the mutex to be held
+    Block& getBlock(int blockX);
+
+public:
+    SurfaceIndex(std::shared_ptr<const PerlinNoise> noise, int worldHeight);
+
+    // Grass height for a run of columns, as generated (ignores edits)
+    void getTerrainHeights(int firstWorldX, int count, int* out);
+    int getTerrainHeight(int worldX);
+
+    // Top ground tile of a column; worldHeight if the column has been dug out completely
+    int surfaceY(int worldX);
+
+    // Keep the surface right after a tile edit. columnTile(y) returns the current tile
+    // at that height in the edited column and is only called when digging out the surface.
+    void onTileChanged(int worldX, int y, TileType type, const std::function<TileType(int)>& columnTile);
+
+    // Forget edits for a run of columns (their chunk is being regenerated from noise)
+    void restoreTerrain(int firstWorldX, int count);
+
+    size_t getBlockCount() const;
+    const PerlinNoise& getNoise() const { return *noise; }
+
+    // Tiles that count as ground - vegetation and water don't
+    static bool isGround(TileType type) {
+        return type != TileType::AIR && type != TileType::WATER &&
+               type != TileType::TRUNK && type != TileType::LEAVES;
+    }
+
+    // Terrain shape shared by the index and anything that needs the raw formula
+    static void computeTerrainHeights(const PerlinNoise& noise, int worldHeight,
+                                      int firstWorldX, int count, int* out);
+};
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
+
 // Enum to define different tile types in the game
-enum class TileType {
+// Stored as a single byte so chunk tile buffers stay compact
+enum class TileType : uint8_t {
     AIR,
     GRASS,
     DIRT,
@@ -20,4 +23,7 @@ enum class TileType {
     IRON_ORE,
     GOLD_ORE,
     DIAMOND_ORE
-}; 
\ No newline at end of file
+}; 
+
+// Number of tile types, for dense lookup tables indexed by TileType
+const int TILE_TYPE_COUNT = static_cast<int>(TileType::DIAMOND_ORE) + 1;
\ No newline at end of file
@@ -1,24 +1,28 @@
 #include "World.h"
 #include <algorithm>
 #include <cmath>
-#include <chrono>
 
 World::World(int height, int tileSize, uint64_t seed) : 
     worldHeight(height),
     tileSize(tileSize),
     currentSeed(seed),
-    terrainNoise(seed),
-    tileManager("assets/textures/")
+    terrainNoise(std::make_shared<PerlinNoise>(seed)),
+    surfaceIndex(std::make_shared<SurfaceIndex>(terrainNoise, height)),
+    biomeMap(std::make_shared<BiomeMap>(terrainNoise, height)),
+    activeChunks(DEFAULT_MAX_ACTIVE_CHUNKS + 2 * UNLOAD_HYSTERESIS_CHUNKS),
+    pendingWrites(CHUNK_SHIFT),
+    generationEpoch(0),
+    centerChunkX(0),
+    loadStartChunkX(0),
+    loadEndChunkX(0),
+    keepStartChunkX(0),
+    keepEndChunkX(0),
+    maxActiveChunks(DEFAULT_MAX_ACTIVE_CHUNKS),
+    prefetchTime(1.0f),
+    maxPrefetchChunks(4),
+    generator(CHUNK_WIDTH, height)
 {
-    // Load textures
-    auto startTime = std::chrono::high_resolution_clock::now();
-    if (!tileManager.loadTextures()) {
-        std::cerr << "Failed to load one or more textures!" << std::endl;
-    } else {
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-        std::cout << "Textures loaded successfully in " << duration.count() << "ms" << std::endl;
-    }
+    std::cout << "Chunk generation running on " << generator.getThreadCount() << " worker threads" << std::endl;
     
     // Initialize with a completely empty world
     // Chunks will be generated on demand when update() is called
@@ -31,83 +35,182 @@ World::~World() {
 }
 
 void World::reset(uint64_t seed) {
-    // Clear all existing chunks
+    // Clear all existing chunks and anything still queued for the old seed
     activeChunks.clear();
+    pendingChunks.clear();
+    chunkCache.clear();
+    pendingWrites.clear();
+    generator.clear();
+    generationEpoch++;
     
     // Set new seed
     currentSeed = seed;
-    terrainNoise = PerlinNoise(seed);
+    terrainNoise = std::make_shared<PerlinNoise>(seed);
+    surfaceIndex = std::make_shared<SurfaceIndex>(terrainNoise, worldHeight);
+    biomeMap = std::make_shared<BiomeMap>(terrainNoise, worldHeight);
     
     // Chunks will be regenerated on next update
 }
 
-void World::update(float viewCenterX) {
-    // Calculate the center chunk
-    int centerChunkX = static_cast<int>(viewCenterX / (CHUNK_WIDTH * tileSize));
+void World::update(float viewLeft, float viewRight, float velocityX) {
+    const float chunkPixels = static_cast<float>(CHUNK_WIDTH * tileSize);
+    
+    // Chunks covered by the actual view span, whatever the zoom level
+    int visibleStartChunkX = static_cast<int>(std::floor(viewLeft / chunkPixels));
+    int visibleEndChunkX = static_cast<int>(std::floor(viewRight / chunkPixels));
+    centerChunkX = static_cast<int>(std::floor((viewLeft + viewRight) * 0.5f / chunkPixels));
+    
+    // Extend the window in the direction of travel by however far the camera
+    // will move within the prefetch time, so chunks are ready before they scroll in
+    int ahead = static_cast<int>(std::ceil(std::abs(velocityX) * prefetchTime / chunkPixels));
+    ahead = std::min(ahead, maxPrefetchChunks);
+    
+    loadStartChunkX = visibleStartChunkX - LOAD_MARGIN_CHUNKS - (velocityX < 0.0f ? ahead : 0);
+    loadEndChunkX = visibleEndChunkX + LOAD_MARGIN_CHUNKS + (velocityX > 0.0f ? ahead : 0);
+    
+    // Over budget (zoomed far out): keep the chunks nearest the centre of the view
+    if (loadEndChunkX - loadStartChunkX + 1 > maxActiveChunks) {
+        loadStartChunkX = centerChunkX - (maxActiveChunks - 1) / 2;
+        loadEndChunkX = loadStartChunkX + maxActiveChunks - 1;
+    }
+    
+    keepStartChunkX = loadStartChunkX - UNLOAD_HYSTERESIS_CHUNKS;
+    keepEndChunkX = loadEndChunkX + UNLOAD_HYSTERESIS_CHUNKS;
+    
+    // Free the ring buffer slots of chunks that left the window before new ones arrive
+    evictChunksOutsideRange();
+    
+    // Pick up whatever the workers finished since the last frame
+    collectGeneratedChunks();
     
-    // Update active chunks based on new center
-    updateActiveChunks(centerChunkX);
+    // Load chunks for the new window
+    updateActiveChunks();
 }
 
-void World::updateActiveChunks(int centerChunkX) {
-    // Performance optimization: Track which chunks need to be generated
-    std::vector<int> chunksToGenerate;
-    
-    // First, mark chunks outside view distance for removal
-    std::vector<int> chunksToRemove;
-    for (auto& pair : activeChunks) {
-        int chunkX = pair.first;
-        if (abs(chunkX - centerChunkX) > MAX_CHUNKS / 2) {
-            chunksToRemove.push_back(chunkX);
+void World::setMaxActiveChunks(int chunks) {
+    maxActiveChunks = std::max(MIN_ACTIVE_CHUNKS, chunks);
+    
+    // The keep range can span the budget plus hysteresis on both sides
+    // Chunks that no longer fit (the budget shrank) go to the cache like any other eviction
+    for (std::unique_ptr<Chunk>& chunk : activeChunks.reserve(maxActiveChunks + 2 * UNLOAD_HYSTERESIS_CHUNKS,
+                                                              centerChunkX)) {
+        chunkCache.put(std::move(chunk));
+    }
+}
+
+void World::collectGeneratedChunks() {
+    generator.collect([this](ChunkGenerator::Result&& result) {
+        // Chunks generated for a previous seed are simply dropped
+        if (result.epoch != generationEpoch) {
+            return;
+        }
+        
+        int chunkX = result.chunk->getChunkX();
+        pendingChunks.erase(chunkX);
+        
+        // Deliver what this chunk placed in its neighbours; loaded ones are patched now,
+        // the rest pick the writes up when they are generated or restored
+        std::vector<int> changedTargets;
+        pendingWrites.add(chunkX, result.overflow, changedTargets);
+        for (int targetX : changedTargets) {
+            if (Chunk* neighbour = activeChunks.get(targetX)) {
+                pendingWrites.applyTo(*neighbour, true);
+            }
+        }
+        
+        // And take what the neighbours already placed in this one
+        pendingWrites.applyTo(*result.chunk, false);
+        
+        // The camera may have moved on while the chunk was being generated;
+        // keep the work in the cache in case it comes back
+        if (chunkX < keepStartChunkX || chunkX > keepEndChunkX) {
+            chunkCache.put(std::move(result.chunk));
+            return;
         }
+        
+        std::unique_ptr<Chunk> displaced = activeChunks.insert(std::move(result.chunk));
+        if (displaced) {
+            chunkCache.put(std::move(displaced));
+        }
+    });
+}
+
+void World::evictChunksOutsideRange() {
+    // Move chunks that have fallen outside the keep range into the cache
+    int evicted = 0;
+    activeChunks.removeIf(
+        [this](const Chunk& chunk) {
+            return chunk.getChunkX() < keepStartChunkX || chunk.getChunkX() > keepEndChunkX;
+        },
+        [this, &evicted](std::unique_ptr<Chunk> chunk) {
+            chunkCache.put(std::move(chunk));
+            evicted++;
+        });
+    if (evicted == 0) {
+        return;
     }
     
-    // Remove chunks outside view distance
-    for (int chunkX : chunksToRemove) {
-        activeChunks.erase(chunkX);
+    // Cross-chunk writes that no chunk in range or in the cache can need any more;
+    // their sources hand them over again if they are ever regenerated
+    pendingWrites.prune([this](int chunkX) {
+        return (chunkX >= keepStartChunkX && chunkX <= keepEndChunkX) || chunkCache.contains(chunkX);
+    });
+}
+
+void World::updateActiveChunks() {
+    // Stop waiting for queued chunks that have scrolled out of range
+    std::vector<int> cancelled;
+    generator.cancelOutside(keepStartChunkX, keepEndChunkX, cancelled);
+    for (int chunkX : cancelled) {
+        pendingChunks.erase(chunkX);
     }
     
-    // Calculate the range of chunks to keep active (centered around the player)
-    int startChunkX = centerChunkX - MAX_CHUNKS / 2;
-    int endChunkX = centerChunkX + MAX_CHUNKS / 2;
+    // Serve the chunks nearest the camera first, so prefetched ones come last
+    generator.setCenter(centerChunkX);
     
-    // Make sure chunks in view range are active
-    for (int x = startChunkX; x <= endChunkX; x++) {
-        // Skip if chunk is already active
-        if (activeChunks.find(x) != activeChunks.end()) {
+    // Make sure chunks in the load range are active or on their way
+    for (int x = loadStartChunkX; x <= loadEndChunkX; x++) {
+        // Skip if chunk is already active or queued
+        if (activeChunks.contains(x) || pendingChunks.count(x)) {
             continue;
         }
         
-        // Create chunk object and generate terrain
-        auto chunk = std::make_unique<Chunk>(
-            x, CHUNK_WIDTH, worldHeight, tileSize,
-            tileManager.getTexture(TileType::GRASS),
-            tileManager.getTexture(TileType::DIRT),
-            tileManager.getTexture(TileType::STONE),
-            tileManager.getTexture(TileType::GRAVELED_STONE),
-            tileManager.getTexture(TileType::TRUNK),
-            tileManager.getTexture(TileType::LEAVES)
-        );
-        
-        // Queue for generation
-        chunksToGenerate.push_back(x);
-        activeChunks[x] = std::move(chunk);
-    }
-    
-    // Generate chunks in a separate phase to allow for multithreading in future
-    for (int x : chunksToGenerate) {
-        auto it = activeChunks.find(x);
-        if (it != activeChunks.end()) {
-            // Calculate the world offset for this chunk
-            int worldOffset = x * CHUNK_WIDTH;
-            it->second->generate(terrainNoise, currentSeed, worldOffset);
+        // Recently evicted chunks come straight back from the cache
+        std::unique_ptr<Chunk> cached = chunkCache.take(x);
+        if (cached) {
+            // Neighbours generated while it was cached may have spilled into it
+            pendingWrites.applyTo(*cached, true);
+            activeChunks.insert(std::move(cached));
+            continue;
         }
+        
+        // Generation happens on the worker pool; the chunk shows up once it is done.
+        // Edits to the old copy of this chunk are gone, so the surface goes back to the terrain.
+        surfaceIndex->restoreTerrain(x * CHUNK_WIDTH, CHUNK_WIDTH);
+        generator.request(x, generationEpoch, surfaceIndex, biomeMap, currentSeed);
+        pendingChunks.insert(x);
     }
 }
 
-void World::draw(sf::RenderWindow& window) {
-    // Draw all active chunks
-    for (auto& pair : activeChunks) {
-        pair.second->draw(window);
+bool World::setTile(int worldTileX, int y, TileType type) {
+    Chunk* chunk = activeChunks.get(worldTileX >> CHUNK_SHIFT);
+    if (!chunk || y < 0 || y >= worldHeight) {
+        return false;
     }
+    
+    int localX = worldTileX & (CHUNK_WIDTH - 1);
+    chunk->setTile(localX, y, type);
+    
+    surfaceIndex->onTileChanged(worldTileX, y, type, [chunk, localX](int row) {
+        return chunk->getTile(localX, row);
+    });
+    return true;
+}
+
+size_t World::getActiveChunkMemory() const {
+    size_t bytes = 0;
+    activeChunks.forEach([&bytes](const Chunk& chunk) {
+        bytes += chunk.getMemoryUsage();
+    });
+    return bytes;
 } 
\ No newline at end of file
@@ -1,43 +1,139 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
 #include <vector>
-#include <map>
+#include <set>
 #include <iostream>
 #include <cstdint>
 #include <memory>
+#include <algorithm>
+#include <utility>
 #include "../engine/PerlinNoise.h"
 #include "Chunk.h"
-#include "TileManager.h"
+#include "ChunkGenerator.h"
+#include "ChunkCache.h"
+#include "ChunkWindow.h"
+#include "PendingTileWrites.h"
+#include "BiomeMap.h"
+#include "SurfaceIndex.h"
 
+// The loaded part of the world: which chunks are active, generating them around the view,
+// caching the ones that leave it and editing tiles. Pure data - nothing here needs a
+// window or a graphics context, so it runs the same headless; WorldRenderer draws it.
 class World {
 private:
-    static const int MAX_CHUNKS = 7;         // Maximum number of active chunks
-    static const int CHUNK_WIDTH = 16;       // Width of a chunk in blocks
-    static const int TOTAL_CHUNKS = 62500;   // Total chunks in the world (1,000,000 / 16)
+    static constexpr int CHUNK_WIDTH = 16;       // Width of a chunk in blocks
+    static constexpr int CHUNK_SHIFT = 4;        // log2(CHUNK_WIDTH), world tile X -> chunk X
+    static_assert(CHUNK_WIDTH == 1 << CHUNK_SHIFT, "CHUNK_WIDTH must be a power of two");
+    static constexpr int TOTAL_CHUNKS = 62500;   // Total chunks in the world (1,000,000 / 16)
+    static constexpr int MAX_PREFETCH_CHUNKS = 8; // Upper bound on chunks generated ahead of the camera
+    static constexpr int LOAD_MARGIN_CHUNKS = 1;  // Chunks loaded beyond each edge of the view
+    static constexpr int UNLOAD_HYSTERESIS_CHUNKS = 2; // Extra distance before a loaded chunk is dropped
+    static constexpr int MIN_ACTIVE_CHUNKS = 3;
+    static constexpr int DEFAULT_MAX_ACTIVE_CHUNKS = 48;
     
     int worldHeight;                         // Height of the world in blocks
     int tileSize;                            // Size of a tile in pixels
     uint64_t currentSeed;                    // Current world seed
     
-    // Perlin noise generator for terrain
-    PerlinNoise terrainNoise;                // For terrain height
+    // Perlin noise generator for terrain, shared read-only with the generation workers
+    std::shared_ptr<const PerlinNoise> terrainNoise;
     
-    // Tile manager
-    TileManager tileManager;
+    // Ground height of every column for the current seed, filled in lazily
+    std::shared_ptr<SurfaceIndex> surfaceIndex;
     
-    // Map of active chunks (key is chunk X position)
-    std::map<int, std::unique_ptr<Chunk>> activeChunks;
+    // Climate and ore fields for the current seed, also filled in lazily
+    std::shared_ptr<BiomeMap> biomeMap;
     
-    void updateActiveChunks(int centerChunkX);
+    // Active chunks in a ring buffer indexed by chunk X
+    ChunkWindow activeChunks;
+    
+    // Chunks requested from the generator that haven't come back yet
+    std::set<int> pendingChunks;
+    
+    // Recently evicted chunks, restored instead of regenerated when the camera comes back
+    ChunkCache chunkCache;
+    
+    // Tree canopies and other features that generation placed across chunk edges
+    PendingTileWrites pendingWrites;
+    
+    // Bumped on reset so chunks generated for an old seed are discarded
+    uint64_t generationEpoch;
+    int centerChunkX;
+    
+    // Chunks in [loadStart, loadEnd] are requested; chunks outside [keepStart, keepEnd] are dropped.
+    // The gap between the two ranges stops chunks thrashing when the view sits on a boundary.
+    int loadStartChunkX;
+    int loadEndChunkX;
+    int keepStartChunkX;
+    int keepEndChunkX;
+    
+    // Budget cap on how many chunks the load range may span
+    int maxActiveChunks;
+    
+    // Prefetch configuration: how far ahead in time to look, and the chunk cap
+    float prefetchTime;
+    int maxPrefetchChunks;
+    
+    // Worker pool - declared last so its threads stop before the shared state they read is destroyed
+    ChunkGenerator generator;
+    
+    void evictChunksOutsideRange();
+    void updateActiveChunks();
+    void collectGeneratedChunks();
     
 public:
     World(int worldHeight, int tileSize, uint64_t seed);
     ~World();
     
     void reset(uint64_t seed);
-    void draw(sf::RenderWindow& window);
-    void update(float viewCenterX);
+    
+    // Load and unload chunks around the horizontal span [viewLeft, viewRight] in pixels
+    void update(float viewLeft, float viewRight, float velocityX = 0.0f);
+    
+    // Visit the loaded chunks left to right
+    template <typename Fn>
+    void forEachActiveChunk(Fn&& fn) const {
+        activeChunks.forEachInRange(keepStartChunkX, keepEndChunkX, std::forward<Fn>(fn));
+    }
+    
+    // Limit on the number of chunks loaded for the view (bounds memory and draw cost when zoomed out)
+    void setMaxActiveChunks(int chunks);
+    int getMaxActiveChunks() const { return maxActiveChunks; }
+    
+    size_t getActiveChunkCount() const { return activeChunks.size(); }
+    size_t getPendingChunkCount() const { return pendingChunks.size(); }
+    size_t getActiveChunkMemory() const;
+    
+    const PendingTileWrites& getPendingWrites() const { return pendingWrites; }
+    
+    ChunkCache& getChunkCache() { return chunkCache; }
+    const ChunkCache& getChunkCache() const { return chunkCache; }
+    
+    // Generate chunks this many seconds ahead of the camera's current velocity
+    void setPrefetchTime(float seconds) { prefetchTime = std::max(0.0f, seconds); }
+    void setMaxPrefetchChunks(int chunks) { maxPrefetchChunks = std::max(0, std::min(chunks, MAX_PREFETCH_CHUNKS)); }
+    float getPrefetchTime() const { return prefetchTime; }
+    int getMaxPrefetchChunks() const { return maxPrefetchChunks; }
+    
+    // Tile lookup in world tile coordinates (AIR if that chunk isn't loaded)
+    TileType getTile(int worldTileX, int y) const {
+        const Chunk* chunk = activeChunks.get(worldTileX >> CHUNK_SHIFT);
+        return chunk ? chunk->getTile(worldTileX & (CHUNK_WIDTH - 1), y) : TileType::AIR;
+    }
+    
+    // Edit a tile in a loaded chunk; returns false if the chunk isn't loaded
+    bool setTile(int worldTileX, int y, TileType type);
+    
+    // Row of the top ground tile in a column, loaded or not (see SurfaceIndex)
+    int getSurfaceY(int worldTileX) const { return surfaceIndex->surfaceY(worldTileX); }
+    SurfaceIndex& getSurfaceIndex() { return *surfaceIndex; }
+    
+    // Stages chunks are generated through, with their timing so far
+    const GenerationPipeline& getGenerationPipeline() const { return generator.getPipeline(); }
+    
+    int getTileSize() const { return tileSize; }
+    int getChunkWidth() const { return CHUNK_WIDTH; }
+    int getLoadMarginChunks() const { return LOAD_MARGIN_CHUNKS; }
     
     // Get dimensions for camera boundaries
     int getWorldWidth() const { return TOTAL_CHUNKS * CHUNK_WIDTH * tileSize; }